@@ -1,11 +1,26 @@
 #include <assert.h>
 #include <fileioc.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "ccdbg/ccdbg.h"
 #include "dictionary.h"
 
 
+// ============================================================================
+// STATIC FUNCTION DECLARATIONS
+// ============================================================================
+
+
+template <uint8_t LENGTH>
+static bool does_word_fit_patterns(
+  IN BasicWord<LENGTH>& word,
+  IN BasicCompiledWordPattern<LENGTH>& pattern,
+  IN BasicCompiledWordPattern<LENGTH>* excluded_patterns,
+  IN uint8_t num_excluded_patterns
+);
+
+
 // ============================================================================
 // PUBLIC FUNCTION DEFINITIONS
 // ============================================================================
@@ -50,20 +65,25 @@ bool dictionary_ArchiveAppvar()
 
 
 // ============================================================================
-// CLASS Dictionary FUNCTION DEFINITIONS
+// CLASS BasicDictionary FUNCTION DEFINITIONS
 // ============================================================================
 
 
-Dictionary::Dictionary()
+template <uint8_t LENGTH>
+BasicDictionary<LENGTH>::BasicDictionary()
 {
+  char appvar_name[sizeof DICTIONARY_APPVAR];
   ti_var_t slot;
 
   this->dictionary_loaded = false;
 
-  if ((slot = ti_Open(DICTIONARY_APPVAR, "r")))
+  strcpy(appvar_name, DICTIONARY_APPVAR);
+  appvar_name[DICTIONARY_APPVAR_LENGTH_INDEX] = '0' + LENGTH;
+
+  if ((slot = ti_Open(appvar_name, "r")))
   {
     ti_Read(&num_words, sizeof num_words, 1, slot);
-    this->word_list = (word_string_t*)ti_GetDataPtr(slot);
+    this->word_list = (basic_word_string_t<LENGTH>*)ti_GetDataPtr(slot);
 
     ti_Close(slot);
     this->dictionary_loaded = true;
@@ -73,13 +93,15 @@ Dictionary::Dictionary()
 }
 
 
-Dictionary::~Dictionary()
+template <uint8_t LENGTH>
+BasicDictionary<LENGTH>::~BasicDictionary()
 {
   return;
 }
 
 
-char* Dictionary::operator[](IN uint24_t index) const
+template <uint8_t LENGTH>
+char* BasicDictionary<LENGTH>::operator[](IN uint24_t index) const
 {
   assert(this->dictionary_loaded);
   assert(index < this->num_words);
@@ -88,23 +110,39 @@ char* Dictionary::operator[](IN uint24_t index) const
 }
 
 
-bool Dictionary::is_loaded() const
+template <uint8_t LENGTH>
+bool BasicDictionary<LENGTH>::is_loaded() const
 {
   return dictionary_loaded;
 }
 
 
-uint24_t Dictionary::get_num_words() const
+template <uint8_t LENGTH>
+uint24_t BasicDictionary<LENGTH>::get_num_words() const
 {
   return this->num_words;
 }
 
 
-bool Dictionary::contains_word(IN Word& word) const
+template <uint8_t LENGTH>
+bool BasicDictionary<LENGTH>::contains_word(
+  IN BasicWord<LENGTH>& word
+) const
+{
+  uint24_t index;
+
+  return find_word(word, index);
+}
+
+
+template <uint8_t LENGTH>
+bool BasicDictionary<LENGTH>::find_word(
+  IN BasicWord<LENGTH>& word, OUT uint24_t& index
+) const
 {
   assert(this->dictionary_loaded);
 
-  Word current_word;
+  BasicWord<LENGTH> current_word;
   int24_t low = 0;
   int24_t mid;
   int24_t high = num_words - 1;
@@ -124,6 +162,7 @@ bool Dictionary::contains_word(IN Word& word) const
     }
     else
     {
+      index = mid;
       return true;
     }
   }
@@ -132,7 +171,10 @@ bool Dictionary::contains_word(IN Word& word) const
 }
 
 
-void Dictionary::get_random_word(OUT Word& random_word) const
+template <uint8_t LENGTH>
+void BasicDictionary<LENGTH>::get_random_word(
+  OUT BasicWord<LENGTH>& random_word
+) const
 {
   assert(this->dictionary_loaded);
 
@@ -141,13 +183,14 @@ void Dictionary::get_random_word(OUT Word& random_word) const
 }
 
 
-void Dictionary::get_random_word_unlike_given_word(
-  IN Word& given_word, OUT Word& random_word
+template <uint8_t LENGTH>
+void BasicDictionary<LENGTH>::get_random_word_unlike_given_word(
+  IN BasicWord<LENGTH>& given_word, OUT BasicWord<LENGTH>& random_word
 ) const
 {
   assert(this->dictionary_loaded);
 
-  Word word;
+  BasicWord<LENGTH> word;
 
   do {
     word = this->word_list[rand() % this->num_words];
@@ -158,41 +201,251 @@ void Dictionary::get_random_word_unlike_given_word(
 }
 
 
-void Dictionary::get_random_word_that_fits_pattern(
-  IN WordPattern& pattern, OUT Word& random_word
+// Picks uniformly among the words that fit the pattern and fit none of the
+// excluded patterns. Returns false, leaving random_word unchanged, if no word
+// fits. See BasicPatternSampler for the cost.
+template <uint8_t LENGTH>
+bool BasicDictionary<LENGTH>::get_random_word_that_fits_pattern(
+  IN BasicCompiledWordPattern<LENGTH>& pattern,
+  IN BasicCompiledWordPattern<LENGTH>* excluded_patterns,
+  IN uint8_t num_excluded_patterns,
+  OUT BasicWord<LENGTH>& random_word
+) const
+{
+  BasicPatternSampler<LENGTH> sampler;
+
+  sampler.start(*this, pattern, excluded_patterns, num_excluded_patterns);
+
+  while (!sampler.step(this->num_words))
+    ;
+
+  return sampler.get_word(random_word);
+}
+
+
+// The list is sorted, so the words with a first letter in the mask (bit `n`
+// stands for 'A' + n) lie between the first word that starts with the lowest
+// letter and the last word that starts with the highest letter.
+template <uint8_t LENGTH>
+void BasicDictionary<LENGTH>::find_words_with_first_letters(
+  IN uint32_t first_letters,
+  OUT uint24_t& start_index,
+  OUT uint24_t& end_index
 ) const
 {
   assert(this->dictionary_loaded);
 
-  const uint24_t STARTING_INDEX = rand() % this->num_words;
-  const uint8_t MAX_NUM_WORD_CHOICES = 50;
+  char first_letter = 'A';
+  char last_letter = 'Z';
+
+  if (first_letters == 0)
+  {
+    start_index = 0;
+    end_index = 0;
+    return;
+  }
+
+  while (!(first_letters & (1UL << (first_letter - 'A'))))
+    first_letter++;
+
+  while (!(first_letters & (1UL << (last_letter - 'A'))))
+    last_letter--;
+
+  start_index = find_first_word_from_letter(first_letter);
+  end_index = find_first_word_from_letter(last_letter + 1);
+  return;
+}
 
-  word_string_t word_choices[MAX_NUM_WORD_CHOICES];
-  Word word;
-  uint24_t index = STARTING_INDEX;
-  uint8_t num_word_choices = 0;
 
-  while (num_word_choices < MAX_NUM_WORD_CHOICES && index < this->num_words)
+// Returns the index of the first word whose first letter is not before the
+// given one, or the number of words if there is no such word.
+template <uint8_t LENGTH>
+uint24_t BasicDictionary<LENGTH>::find_first_word_from_letter(
+  IN char letter
+) const
+{
+  uint24_t low = 0;
+  uint24_t mid;
+  uint24_t high = this->num_words;
+
+  while (low < high)
   {
-    word = this->word_list[index];
+    mid = (low + high) / 2;
+
+    if (this->word_list[mid][0] < letter)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+
+  return low;
+}
+
+
+// ============================================================================
+// CLASS BasicPatternSampler FUNCTION DEFINITIONS
+// ============================================================================
+
+
+template <uint8_t LENGTH>
+BasicPatternSampler<LENGTH>::BasicPatternSampler()
+{
+  this->dictionary = NULL;
+  this->excluded_patterns = NULL;
+  this->num_excluded_patterns = 0;
+  this->is_word_found = false;
+  this->state = FINISHED;
+  return;
+}
 
-    if (pattern.matches_word(word))
+
+// Only the words whose first letter the pattern allows are visited, and each
+// of those at most twice: once to count the matches and once to find the
+// chosen one.
+template <uint8_t LENGTH>
+void BasicPatternSampler<LENGTH>::start(
+  IN BasicDictionary<LENGTH>& dictionary,
+  IN BasicCompiledWordPattern<LENGTH>& pattern,
+  IN BasicCompiledWordPattern<LENGTH>* excluded_patterns,
+  IN uint8_t num_excluded_patterns
+)
+{
+  this->dictionary = &dictionary;
+  this->pattern = pattern;
+  this->excluded_patterns = excluded_patterns;
+  this->num_excluded_patterns = num_excluded_patterns;
+
+  dictionary.find_words_with_first_letters(
+    pattern.get_allowed_letters(0), this->start_index, this->end_index
+  );
+
+  this->index = this->start_index;
+  this->num_matches = 0;
+  this->is_word_found = false;
+  this->state = COUNTING;
+  return;
+}
+
+
+// Visits at most `max_num_words` words and returns true once the query has
+// finished.
+template <uint8_t LENGTH>
+bool BasicPatternSampler<LENGTH>::step(IN uint24_t max_num_words)
+{
+  uint24_t num_words_left = max_num_words;
+
+  while (this->state == COUNTING && num_words_left > 0)
+  {
+    if (this->index == this->end_index)
     {
-      memcpy(
-        word_choices[num_word_choices], this->word_list[index], WORD_LENGTH
-      );
-      num_word_choices++;
+      if (this->num_matches == 0)
+      {
+        this->state = FINISHED;
+      }
+      else
+      {
+        this->choice = rand() % this->num_matches;
+        this->index = this->start_index;
+        this->state = SELECTING;
+      }
+
+      break;
     }
 
-    index++;
+    if (does_current_word_fit())
+      this->num_matches++;
 
-    if (index == this->num_words)
-      index = 0;
+    this->index++;
+    num_words_left--;
+  }
 
-    if (index == STARTING_INDEX)
-      break;
+  while (this->state == SELECTING && num_words_left > 0)
+  {
+    if (does_current_word_fit())
+    {
+      if (this->choice == 0)
+      {
+        this->word = (*this->dictionary)[this->index];
+        this->is_word_found = true;
+        this->state = FINISHED;
+        break;
+      }
+
+      this->choice--;
+    }
+
+    this->index++;
+    num_words_left--;
   }
 
-  random_word = word_choices[rand() % num_word_choices];
-  return;
+  return this->state == FINISHED;
+}
+
+
+template <uint8_t LENGTH>
+bool BasicPatternSampler<LENGTH>::is_finished() const
+{
+  return this->state == FINISHED;
 }
+
+
+// Returns false, leaving `word` unchanged, if the query has not finished or
+// no word fit.
+template <uint8_t LENGTH>
+bool BasicPatternSampler<LENGTH>::get_word(OUT BasicWord<LENGTH>& word) const
+{
+  if (!this->is_word_found)
+    return false;
+
+  word = this->word;
+  return true;
+}
+
+
+template <uint8_t LENGTH>
+bool BasicPatternSampler<LENGTH>::does_current_word_fit() const
+{
+  BasicWord<LENGTH> word((*this->dictionary)[this->index]);
+
+  return does_word_fit_patterns(
+    word,
+    this->pattern,
+    this->excluded_patterns,
+    this->num_excluded_patterns
+  );
+}
+
+
+// ============================================================================
+// STATIC FUNCTION DEFINITIONS
+// ============================================================================
+
+
+template <uint8_t LENGTH>
+static bool does_word_fit_patterns(
+  IN BasicWord<LENGTH>& word,
+  IN BasicCompiledWordPattern<LENGTH>& pattern,
+  IN BasicCompiledWordPattern<LENGTH>* excluded_patterns,
+  IN uint8_t num_excluded_patterns
+)
+{
+  if (!pattern.matches_word(word))
+    return false;
+
+  for (uint8_t index = 0; index < num_excluded_patterns; index++)
+  {
+    if (excluded_patterns[index].matches_word(word))
+      return false;
+  }
+
+  return true;
+}
+
+
+// ============================================================================
+// EXPLICIT INSTANTIATIONS
+// ============================================================================
+
+
+template class BasicDictionary<WORD_LENGTH>;
+template class BasicPatternSampler<WORD_LENGTH>;
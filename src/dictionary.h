@@ -13,6 +13,11 @@
 
 #define DICTIONARY_APPVAR ("GIMME5D")
 
+// Dictionaries of other word lengths use the same name with the length in
+// place of the 5 (GIMME4D, GIMME6D, GIMME7D). Each appvar is a 24-bit word
+// count followed by the sorted, uppercase words without terminators.
+#define DICTIONARY_APPVAR_LENGTH_INDEX (5)
+
 
 // ============================================================================
 // PUBLIC FUNCTION DECLARATIONS
@@ -28,29 +33,95 @@ bool dictionary_ArchiveAppvar();
 // ============================================================================
 
 
-class Dictionary
+template <uint8_t LENGTH>
+class BasicDictionary
 {
   public:
-    Dictionary();
-    ~Dictionary();
+    BasicDictionary();
+    ~BasicDictionary();
 
     char* operator[](IN uint24_t index) const;
     bool is_loaded() const;
     uint24_t get_num_words() const;
-    bool contains_word(IN Word& word) const;
-    void get_random_word(OUT Word& random_word) const;
+    bool contains_word(IN BasicWord<LENGTH>& word) const;
+    bool find_word(IN BasicWord<LENGTH>& word, OUT uint24_t& index) const;
+    void find_words_with_first_letters(
+      IN uint32_t first_letters,
+      OUT uint24_t& start_index,
+      OUT uint24_t& end_index
+    ) const;
+    void get_random_word(OUT BasicWord<LENGTH>& random_word) const;
     void get_random_word_unlike_given_word(
-      IN Word& given_word, OUT Word& random_word
+      IN BasicWord<LENGTH>& given_word, OUT BasicWord<LENGTH>& random_word
     ) const;
-    void get_random_word_that_fits_pattern(
-      IN WordPattern& pattern, OUT Word& random_word
+    bool get_random_word_that_fits_pattern(
+      IN BasicCompiledWordPattern<LENGTH>& pattern,
+      IN BasicCompiledWordPattern<LENGTH>* excluded_patterns,
+      IN uint8_t num_excluded_patterns,
+      OUT BasicWord<LENGTH>& random_word
     ) const;
 
   private:
     bool dictionary_loaded;
-    word_string_t* word_list;
+    basic_word_string_t<LENGTH>* word_list;
     uint24_t num_words;
+
+    uint24_t find_first_word_from_letter(IN char letter) const;
 };
 
 
+// Runs the same query as BasicDictionary::get_random_word_that_fits_pattern()
+// a few words at a time, so that it can be spread across several frames. The
+// excluded patterns are not copied and must outlive the query.
+template <uint8_t LENGTH>
+class BasicPatternSampler
+{
+  public:
+    BasicPatternSampler();
+
+    void start(
+      IN BasicDictionary<LENGTH>& dictionary,
+      IN BasicCompiledWordPattern<LENGTH>& pattern,
+      IN BasicCompiledWordPattern<LENGTH>* excluded_patterns,
+      IN uint8_t num_excluded_patterns
+    );
+    bool step(IN uint24_t max_num_words);
+
+    bool is_finished() const;
+    bool get_word(OUT BasicWord<LENGTH>& word) const;
+
+  private:
+    enum sampler_state_t : uint8_t
+    {
+      COUNTING = 0,
+      SELECTING,
+      FINISHED
+    };
+
+    const BasicDictionary<LENGTH>* dictionary;
+    BasicCompiledWordPattern<LENGTH> pattern;
+    const BasicCompiledWordPattern<LENGTH>* excluded_patterns;
+    uint8_t num_excluded_patterns;
+    uint24_t start_index;
+    uint24_t end_index;
+    uint24_t index;
+    uint24_t num_matches;
+    uint24_t choice;
+    BasicWord<LENGTH> word;
+    bool is_word_found;
+    sampler_state_t state;
+
+    bool does_current_word_fit() const;
+};
+
+
+typedef BasicDictionary<WORD_LENGTH> Dictionary;
+typedef BasicPatternSampler<WORD_LENGTH> PatternSampler;
+
+// Only the lengths that a gameplay mode plays are instantiated, in
+// dictionary.cpp.
+extern template class BasicDictionary<WORD_LENGTH>;
+extern template class BasicPatternSampler<WORD_LENGTH>;
+
+
 #endif
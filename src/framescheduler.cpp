@@ -0,0 +1,58 @@
+#include "framescheduler.h"
+#include "keypad.h"
+
+
+// ============================================================================
+// CLASS FrameScheduler FUNCTION DEFINITIONS
+// ============================================================================
+
+
+// Waits for the next frame and then reads the keypad. Every polling loop calls
+// this where it used to call Keypad::update_state().
+void FrameScheduler::start_frame()
+{
+  wait_for_next_frame();
+  Keypad::update_state();
+  return;
+}
+
+
+// Frames are spaced from the last frame's deadline, so the frame rate does not
+// drift. A frame that ran more than a whole frame over starts the count again
+// from now rather than letting the next frames run back to back to catch up.
+//
+// The wait polls the clock. Halting the CPU would need an interrupt that is
+// sure to come before the deadline, and SystemClock runs its timer without
+// one.
+void FrameScheduler::wait_for_next_frame()
+{
+  ticks_t timestamp = SystemClock::now();
+
+  last_frame_busy_time = timestamp - frame_start_timestamp;
+
+  if (
+    SystemClock::has_reached(timestamp, next_frame_deadline + TICKS_PER_FRAME)
+  )
+  {
+    next_frame_deadline = timestamp;
+  }
+
+  while (!SystemClock::has_reached(timestamp, next_frame_deadline))
+    timestamp = SystemClock::now();
+
+  frame_start_timestamp = timestamp;
+  next_frame_deadline += TICKS_PER_FRAME;
+  return;
+}
+
+
+// How long the previous frame spent working before it waited for this one.
+ticks_t FrameScheduler::get_last_frame_busy_time()
+{
+  return last_frame_busy_time;
+}
+
+
+ticks_t FrameScheduler::next_frame_deadline = 0;
+ticks_t FrameScheduler::frame_start_timestamp = 0;
+ticks_t FrameScheduler::last_frame_busy_time = 0;
@@ -0,0 +1,44 @@
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+
+#include <stdint.h>
+
+#include "systemclock.h"
+#include "typehints.h"
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+#define FRAMES_PER_SECOND (30)
+#define TICKS_PER_FRAME   (TICKS_PER_SECOND / FRAMES_PER_SECOND)
+
+
+// ============================================================================
+// CLASS DECLARATIONS
+// ============================================================================
+
+
+// Paces every loop that polls the keypad to a fixed frame rate, so that loops
+// with nothing to do only read the keypad and the clock between frames instead
+// of redrawing and blitting as fast as they can.
+class FrameScheduler
+{
+  public:
+    static void start_frame();
+    static void wait_for_next_frame();
+    static ticks_t get_last_frame_busy_time();
+
+  private:
+    static ticks_t next_frame_deadline;
+    static ticks_t frame_start_timestamp;
+    static ticks_t last_frame_busy_time;
+
+    FrameScheduler();
+};
+
+
+#endif
@@ -3,28 +3,59 @@
 #include <assert.h>
 #include <debug.h>
 #include <keypadc.h>
+#include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
 #include "ccdbg/ccdbg.h"
 #include "gfx/gfx.h"
+#include "framescheduler.h"
 #include "gameplay.h"
 #include "gui.h"
 #include "ingamehelp.h"
 #include "keypad.h"
 
 
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+// The tile sprites in gfx/ are TILE_SIZE pixels on a side. UNEVALUATED and
+// POSITION_AND_LETTER_INCORRECT share the blue tile.
+#define TILE_SIZE        (20)
+#define NUM_TILE_SPRITES (3)
+
+// Every lettered tile is kept as a sprite the first time it is drawn, so that
+// drawing it again is one sprite copy instead of a tile and a shadowed glyph.
+// A sprite that has not been drawn yet has a width of zero. The cache takes
+// about 31 KB, so it is only allocated once a mode draws a full-size tile,
+// and it is freed when that mode ends. If it cannot be allocated, tiles are
+// drawn without it.
+typedef uint8_t cached_tile_set_t[ALPHABET_LENGTH][2 + (TILE_SIZE * TILE_SIZE)];
+
+static cached_tile_set_t* cached_tiles = NULL;
+
+
 // ============================================================================
 // STATIC FUNCTION DECLARATIONS
 // ============================================================================
 
 
+static uint8_t get_tile_sprite_index(IN evaluation_code_t evaluation_code);
+static void draw_tile_sprite(IN gfx_sprite_t* sprite, IN point_t& origin);
 static void draw_character_tile(
   IN evaluation_code_t evaluation_code, IN point_t& origin
 );
 static void draw_character_and_tile(
   IN char character, IN evaluation_code_t evaluation_code, IN point_t& origin
 );
+static void draw_compact_character_and_tile(
+  IN char character,
+  IN evaluation_code_t evaluation_code,
+  IN point_t& origin,
+  IN uint8_t tile_size
+);
 
 
 // ============================================================================
@@ -44,6 +75,15 @@ uint8_t Gameplay::get_id() const
 }
 
 
+// Called when a mode's play function returns.
+void Gameplay::free_tile_cache()
+{
+  free(cached_tiles);
+  cached_tiles = NULL;
+  return;
+}
+
+
 void Gameplay::draw_word_input(IN word_string_t word) const
 {
   const uint24_t HORIZONTAL_SPACING = 6;
@@ -56,6 +96,12 @@ void Gameplay::draw_word_input(IN word_string_t word) const
     .xpos = (LCD_WIDTH - INPUT_WIDTH) / 2,
     .ypos = 205
   };
+  rectangle_t region = {
+    .xpos = tile_origin.xpos,
+    .ypos = tile_origin.ypos,
+    .width = INPUT_WIDTH + 1,
+    .height = (uint8_t)(spr_character_slot->height + 4)
+  };
   char letter;
 
   gfx_SetColor(DARK_MED_BLUE);
@@ -91,6 +137,8 @@ void Gameplay::draw_word_input(IN word_string_t word) const
 
     tile_origin.xpos += spr_character_slot->width + HORIZONTAL_SPACING;
   }
+
+  gui_MarkDirty(region);
   return;
 }
 
@@ -158,6 +206,45 @@ void Gameplay::draw_evaluated_guess(
     tile_origin.xpos += spr_character_slot->width + HORIZONTAL_SPACING;
   }
 
+  // Empty slots are drawn here rather than by draw_character_and_tile().
+  rectangle_t region = {
+    .xpos = origin.xpos - (WIDTH / 2),
+    .ypos = origin.ypos,
+    .width = WIDTH + 1,
+    .height = (uint8_t)(spr_character_slot->height + 1)
+  };
+
+  gui_MarkDirty(region);
+  return;
+}
+
+
+// Draws a guess with small, flat tiles so that several boards fit on the
+// screen at once. Empty letters are drawn as empty slots.
+void Gameplay::draw_compact_evaluated_guess(
+  IN Word& word, IN word_evaluation_t evaluation, IN point_t& origin
+) const
+{
+  const uint24_t WIDTH = (
+    (WORD_LENGTH * (COMPACT_TILE_SIZE + COMPACT_TILE_SPACING))
+    - COMPACT_TILE_SPACING
+  );
+
+  assert(origin.xpos >= (WIDTH / 2));
+
+  point_t tile_origin = {
+    .xpos = origin.xpos - (WIDTH / 2),
+    .ypos = origin.ypos
+  };
+
+  for (uint8_t index = 0; index < WORD_LENGTH; index++)
+  {
+    draw_compact_character_and_tile(
+      word[index], evaluation[index], tile_origin, COMPACT_TILE_SIZE
+    );
+    tile_origin.xpos += COMPACT_TILE_SIZE + COMPACT_TILE_SPACING;
+  }
+
   return;
 }
 
@@ -166,14 +253,19 @@ pause_menu_code_t Gameplay::pause_menu(
   IN char** button_titles, IN uint8_t num_options
 ) const
 {
+  const uint8_t MAX_NUM_OPTIONS = 3;
+
   GuiText text;
   Container container;
   Container header;
+  Widget menu;
+  ButtonWidget buttons[MAX_NUM_OPTIONS];
+  TextWidget help_text;
   uint8_t option_index = 0;
-  uint8_t button_ypos;
-  bool first_draw = true;
   bool draw_help = false;
 
+  assert(num_options <= MAX_NUM_OPTIONS);
+
   gfx_SetColor(BLACK);
 
   for (uint8_t ypos = 0; ypos < LCD_HEIGHT; ypos += 2)
@@ -186,7 +278,7 @@ pause_menu_code_t Gameplay::pause_menu(
   header.set_width(150);
   header.set_height(30);
   header.center_horizontally_on_screen();
-  header.center_vertically_on_ypos(container.get_ypos());
+  header.center_vertically_on_ypos(container.get_ypos() + 1);
   header.set_color(DARK_MED_BLUE);
   header.set_border_radius(14);
   header.set_z_index(0);
@@ -199,38 +291,34 @@ pause_menu_code_t Gameplay::pause_menu(
   text.set_ypos(header.get_ypos() + 7);
   text.draw_centered_string("PAUSED");
 
-  while (true)
+  for (uint8_t index = 0; index < num_options; index++)
   {
-    button_ypos = container.get_ypos() + 45;
+    buttons[index].set_title(button_titles[index]);
+    buttons[index].set_ypos(container.get_ypos() + 46 + (index * 35));
+    menu.add_child(buttons[index]);
+  }
 
-    for (uint8_t index = 0; index < num_options; index++)
-    {
-      if (option_index == index)
-        gui_DrawButtonSelected(button_titles[index], button_ypos);
-      else
-        gui_DrawButton(button_titles[index], button_ypos);
+  help_text.set_string("[clear]: Quit game");
+  help_text.set_font(GuiText::NORMAL_SIZE_WITH_SHADOW);
+  help_text.set_ypos(container.get_ypos() + 51 + (num_options * 35));
 
-      button_ypos += 35;
-    }
+  gui_ClearNotifications();
 
-    if (draw_help)
-    {
-      text.set_font(GuiText::NORMAL_SIZE_WITH_SHADOW);
-      text.set_ypos(button_ypos + 5);
-      text.draw_centered_string("[clear]: Quit game");
-    }
+  // The dimmed game screen under the menu is only shown once.
+  gui_MarkScreenDirty();
 
-    if (first_draw)
-    {
-      gfx_BlitBuffer();
-      first_draw = false;
-    }
-    else
-    {
-      gfx_SwapDraw();
-    }
+  while (true)
+  {
+    for (uint8_t index = 0; index < num_options; index++)
+      buttons[index].set_selected(index == option_index);
 
-    Keypad::update_state();
+    menu.render();
+    gui_BlitDirtyRegions();
+
+    // Nothing in the menu changes without a key press.
+    do {
+      FrameScheduler::start_frame();
+    } while (Keypad::is_idle());
 
     if (Keypad::is_down_repeating(kb_KeyUp))
     {
@@ -246,8 +334,9 @@ pause_menu_code_t Gameplay::pause_menu(
       else
         option_index = 0;
     }
-    else if (Keypad::was_released_exclusive(kb_KeyMode))
+    else if (Keypad::was_released_exclusive(kb_KeyMode) && !draw_help)
     {
+      menu.add_child(help_text);
       draw_help = true;
     }
     else if (Keypad::was_released_exclusive(kb_KeyClear))
@@ -274,33 +363,56 @@ pause_menu_code_t Gameplay::pause_menu(
 // ============================================================================
 
 
-static void draw_character_tile(
-  IN evaluation_code_t evaluation_code, IN point_t& origin
-)
+static uint8_t get_tile_sprite_index(IN evaluation_code_t evaluation_code)
 {
-  gfx_sprite_t* sprite;
-
   switch (evaluation_code)
   {
     case LETTER_CORRECT:
-      sprite = spr_character_tile_orange;
-      break;
+      return 1;
 
     case POSITION_AND_LETTER_CORRECT:
-      sprite = spr_character_tile_green;
-      break;
+      return 2;
 
     case UNEVALUATED:
     case POSITION_AND_LETTER_INCORRECT:
     default:
-      sprite = spr_character_tile_blue;
-      break;
+      return 0;
   }
+}
 
+
+static void draw_tile_sprite(IN gfx_sprite_t* sprite, IN point_t& origin)
+{
   gfx_SetColor(BLACK);
   gfx_HorizLine(origin.xpos + 1, origin.ypos + sprite->height, sprite->width);
   gfx_VertLine(origin.xpos + sprite->width, origin.ypos + 1, sprite->height);
   gfx_Sprite_NoClip(sprite, origin.xpos, origin.ypos);
+
+  rectangle_t region = {
+    .xpos = origin.xpos,
+    .ypos = origin.ypos,
+    .width = (uint24_t)(sprite->width + 1),
+    .height = (uint8_t)(sprite->height + 1)
+  };
+
+  gui_MarkDirty(region);
+  return;
+}
+
+
+static void draw_character_tile(
+  IN evaluation_code_t evaluation_code, IN point_t& origin
+)
+{
+  gfx_sprite_t* const TILE_SPRITES[NUM_TILE_SPRITES] = {
+    spr_character_tile_blue,
+    spr_character_tile_orange,
+    spr_character_tile_green
+  };
+
+  draw_tile_sprite(
+    TILE_SPRITES[get_tile_sprite_index(evaluation_code)], origin
+  );
   return;
 }
 
@@ -309,12 +421,102 @@ static void draw_character_and_tile(
   IN char character, IN evaluation_code_t evaluation_code, IN point_t& origin
 )
 {
+  assert(character >= 'A' && character <= 'Z');
+
+  gfx_sprite_t* cached_tile = NULL;
   GuiText text;
 
+  if (cached_tiles == NULL)
+  {
+    cached_tiles = (cached_tile_set_t*)calloc(
+      NUM_TILE_SPRITES, sizeof(cached_tile_set_t)
+    );
+  }
+
+  if (cached_tiles != NULL)
+  {
+    cached_tile = (gfx_sprite_t*)cached_tiles[
+      get_tile_sprite_index(evaluation_code)
+    ][character - 'A'];
+  }
+
+  if (cached_tile != NULL && cached_tile->width > 0)
+  {
+    draw_tile_sprite(cached_tile, origin);
+    return;
+  }
+
   draw_character_tile(evaluation_code, origin);
   text.set_font(GuiText::TILE_CHARACTER);
-  text.set_xpos(origin.xpos + ((20 - gfx_GetCharWidth(character)) / 2));
+  text.set_xpos(
+    origin.xpos + ((TILE_SIZE - gfx_GetCharWidth(character)) / 2)
+  );
   text.set_ypos(origin.ypos + 3);
   text.draw_character(character);
+
+  if (cached_tile == NULL)
+    return;
+
+  // The glyph and its shadow lie inside the tile, so the finished tile can be
+  // read straight back from the buffer.
+  cached_tile->width = TILE_SIZE;
+  cached_tile->height = TILE_SIZE;
+  gfx_GetSprite(cached_tile, origin.xpos, origin.ypos);
+  return;
+}
+
+
+static void draw_compact_character_and_tile(
+  IN char character,
+  IN evaluation_code_t evaluation_code,
+  IN point_t& origin,
+  IN uint8_t tile_size
+)
+{
+  GuiText text;
+
+  rectangle_t region = {
+    .xpos = origin.xpos,
+    .ypos = origin.ypos,
+    .width = tile_size,
+    .height = tile_size
+  };
+
+  gui_MarkDirty(region);
+
+  if (character == '\0')
+  {
+    gfx_SetColor(BLACK);
+    gfx_FillRectangle_NoClip(origin.xpos, origin.ypos, tile_size, tile_size);
+    return;
+  }
+
+  switch (evaluation_code)
+  {
+    case LETTER_CORRECT:
+      gfx_SetColor(ORANGE);
+      break;
+
+    case POSITION_AND_LETTER_CORRECT:
+      gfx_SetColor(GREEN);
+      break;
+
+    case UNEVALUATED:
+      gfx_SetColor(LIGHT_MED_BLUE);
+      break;
+
+    case POSITION_AND_LETTER_INCORRECT:
+    default:
+      gfx_SetColor(BLUE);
+      break;
+  }
+
+  gfx_FillRectangle_NoClip(origin.xpos, origin.ypos, tile_size, tile_size);
+  text.set_font(GuiText::DEFAULT);
+  text.set_xpos(
+    origin.xpos + ((tile_size - gfx_GetCharWidth(character) + 1) / 2)
+  );
+  text.set_ypos(origin.ypos + 1);
+  text.draw_character(character);
   return;
 }
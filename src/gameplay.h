@@ -6,6 +6,7 @@
 
 #include "dictionary.h"
 #include "gui.h"
+#include "scheduler.h"
 #include "word.h"
 
 
@@ -39,7 +40,15 @@ class Gameplay
 
     uint8_t get_id() const;
 
+    static void free_tile_cache();
+
   protected:
+    static const uint8_t COMPACT_TILE_SIZE = 10;
+    static const uint8_t COMPACT_TILE_SPACING = 1;
+
+    // Work that the play loop spreads across frames with nothing to redraw.
+    Scheduler scheduler;
+
     void draw_word_input(IN word_string_t word) const;
     void draw_guess_evaluation(
       IN word_evaluation_t evaluation, IN point_t& origin
@@ -47,6 +56,9 @@ class Gameplay
     void draw_evaluated_guess(
       IN Word& word, IN word_evaluation_t evaluation, IN point_t& origin
     ) const;
+    void draw_compact_evaluated_guess(
+      IN Word& word, IN word_evaluation_t evaluation, IN point_t& origin
+    ) const;
     pause_menu_code_t pause_menu(
       IN char** button_titles, IN uint8_t num_options
     ) const;
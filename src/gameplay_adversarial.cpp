@@ -0,0 +1,544 @@
+#include <sys/lcd.h>
+#include <sys/timers.h>
+#include <assert.h>
+#include <debug.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gfx/gfx.h"
+#include "framescheduler.h"
+#include "gameplay_adversarial.h"
+#include "gui.h"
+#include "ingamehelp.h"
+#include "keypad.h"
+#include "paletteeffects.h"
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+#define ALL_CORRECT_PATTERN (NUM_EVALUATION_PATTERNS - 1)
+
+// The candidate list holds every dictionary word at the start of a game, which
+// is far too large for the stack that the gameplay objects live on. It is only
+// allocated while a game is being played.
+static uint16_t* candidates = NULL;
+static evaluation_pattern_t* candidate_patterns = NULL;
+
+
+// ============================================================================
+// CLASS AdversarialGameplay FUNCTION DEFINITIONS
+// ============================================================================
+
+
+AdversarialGameplay::AdversarialGameplay(): Gameplay(ID)
+{
+  return;
+}
+
+
+void AdversarialGameplay::play_random_word()
+{
+  const pause_menu_code_t SHOW_WORD = OPTION_TWO;
+
+  Word guess;
+  word_string_t input = { '\0' };
+  char letter;
+  uint8_t num_letters = 0;
+  bool transition_in = true;
+  bool full_redraw = true;
+  uint8_t pause_menu_decision = NO_DECISION;
+
+  if (!allocate_candidates())
+  {
+    gui_Notification("Not enough memory!");
+    return;
+  }
+
+  gui_TransitionOut();
+  reset_guesses();
+
+  if (InGameHelp::must_show_help_for(InGameHelp::ADVERSARIAL_GAMEPLAY))
+    show_help_screen();
+
+  while (true)
+  {
+    FrameScheduler::start_frame();
+
+    if (
+      !transition_in && !full_redraw && Keypad::is_idle()
+      && !gui_IsNotificationShowing()
+    )
+      continue;
+
+    if (Keypad::was_released_exclusive(kb_KeyMode))
+    {
+      gui_TransitionOut();
+      show_help_screen();
+      full_redraw = true;
+      transition_in = true;
+    }
+    else if (Keypad::was_released_exclusive(kb_KeyClear))
+    {
+      pause_menu_decision = pause_menu();
+
+      if (pause_menu_decision == QUIT_GAME)
+        break;
+      else
+        full_redraw = true;
+    }
+    else if (
+      keypad_GetUppercaseAsciiLetter(letter) && num_letters < WORD_LENGTH
+    )
+    {
+      input[num_letters] = letter;
+      num_letters++;
+    }
+    else if (Keypad::is_down_repeating(kb_KeyDel) && num_letters > 0)
+    {
+      num_letters--;
+      input[num_letters] = '\0';
+    }
+    else if (
+      Keypad::was_released_exclusive(kb_Key2nd)
+      || Keypad::was_released_exclusive(kb_KeyEnter)
+    )
+    {
+      guess = input;
+
+      if (dictionary.contains_word(guess))
+      {
+        add_guess(input);
+        memset(input, '\0', WORD_LENGTH);
+        num_letters = 0;
+      }
+      else
+      {
+        gui_QueueNotification("Not a dictionary word!");
+      }
+    }
+
+    if (full_redraw)
+    {
+      gui_DrawGameScreenBackground();
+      full_redraw = false;
+    }
+
+    draw_game_screen_foreground(input);
+
+    if (transition_in)
+    {
+      gui_TransitionIn();
+      transition_in = false;
+    }
+
+    gui_MarkScreenDirty();
+    gui_BlitDirtyRegions();
+
+    if (is_last_guess_correct())
+    {
+      draw_win_animation();
+      Keypad::block_until_any_key_released();
+      break;
+    }
+    else if (are_all_guesses_used() || (pause_menu_decision == SHOW_WORD))
+    {
+      draw_lose_animation();
+      Keypad::block_until_any_key_released();
+      break;
+    }
+  }
+
+  gui_TransitionOut();
+  free_candidates();
+  return;
+}
+
+
+void AdversarialGameplay::draw_game_screen_foreground(
+  IN word_string_t current_guess
+) const
+{
+  draw_guesses();
+  draw_num_candidates();
+  draw_word_input(current_guess);
+  return;
+}
+
+
+// Only the most recent guesses fit on the screen.
+void AdversarialGameplay::draw_guesses() const
+{
+  const uint8_t START_INDEX = (
+    this->num_guesses > NUM_VISIBLE_GUESSES
+    ? this->num_guesses - NUM_VISIBLE_GUESSES
+    : 0
+  );
+
+  GuiText text;
+  point_t origin = {
+    .xpos = (LCD_WIDTH / 2),
+    .ypos = 15
+  };
+
+  text.set_font(GuiText::NORMAL_SIZE_WITH_SHADOW);
+
+  for (
+    uint8_t index = START_INDEX;
+    index < START_INDEX + NUM_VISIBLE_GUESSES;
+    index++
+  )
+  {
+    // The numbers shift once the guesses start scrolling.
+    rectangle_t number = {
+      .xpos = 70,
+      .ypos = origin.ypos,
+      .width = 30,
+      .height = spr_character_slot->height
+    };
+
+    gui_RestoreBackground(number);
+
+    if (index < this->num_guesses)
+    {
+      text.set_xpos(70);
+      text.set_ypos(origin.ypos + 7);
+      text.draw_unsigned_int(index + 1);
+    }
+
+    draw_evaluated_guess(
+      guesses[index], guess_evaluations[index], origin
+    );
+
+    origin.ypos += spr_character_slot->height + 5;
+  }
+
+  return;
+}
+
+
+void AdversarialGameplay::draw_num_candidates() const
+{
+  const uint8_t YPOS = 170;
+
+  GuiText text;
+
+  rectangle_t line = {
+    .xpos = 33,
+    .ypos = (uint8_t)(YPOS - 2),
+    .width = 254,
+    .height = GFX_DEFAULT_FONT_HEIGHT + 4
+  };
+
+  gui_RestoreBackground(line);
+
+  text.set_font(GuiText::NORMAL_SIZE_WITH_SHADOW);
+  text.set_ypos(YPOS);
+  text.set_xpos(110);
+  text.draw_string("Words left: ");
+  text.draw_unsigned_int(this->num_candidates);
+  return;
+}
+
+
+void AdversarialGameplay::draw_win_animation() const
+{
+  const uint24_t RECTANGLE_WIDTH = 200;
+  const uint24_t RECTANGLE_XPOS = (LCD_WIDTH - RECTANGLE_WIDTH) / 2;
+
+  GuiText text;
+  word_string_t empty_string = { '\0' };
+
+  gfx_SetColor(GREEN);
+  gfx_FillRectangle_NoClip(RECTANGLE_XPOS, 0, RECTANGLE_WIDTH, LCD_HEIGHT);
+
+  text.set_font(GuiText::GAME_COMPLETION);
+  text.set_ypos(100);
+  text.draw_centered_string("YOU");
+  text.set_ypos(124);
+  text.draw_centered_string("WIN!");
+  gui_MarkScreenDirty();
+  gui_BlitDirtyRegions();
+  PaletteEffects::flash(GREEN, 3, (5 * TICKS_PER_SECOND) / 2);
+  PaletteEffects::fade(PALETTE_FULL_LEVEL, 0, TICKS_PER_SECOND / 4);
+  gui_DrawGameScreenBackground();
+  draw_game_screen_foreground(empty_string);
+  gui_MarkScreenDirty();
+  gui_BlitDirtyRegions();
+  PaletteEffects::fade(0, PALETTE_FULL_LEVEL, TICKS_PER_SECOND / 4);
+
+  return;
+}
+
+
+void AdversarialGameplay::draw_lose_animation() const
+{
+  const uint24_t RECTANGLE_WIDTH = 200;
+  const uint24_t RECTANGLE_XPOS = (LCD_WIDTH - RECTANGLE_WIDTH) / 2;
+
+  GuiText text;
+  Word remaining_word;
+  word_string_t remaining_word_string;
+
+  gfx_SetColor(DARK_ORANGE);
+  gfx_FillRectangle_NoClip(RECTANGLE_XPOS, 0, RECTANGLE_WIDTH, LCD_HEIGHT);
+
+  text.set_font(GuiText::GAME_COMPLETION);
+  text.set_ypos(100);
+  text.draw_centered_string("GAME");
+  text.set_ypos(124);
+  text.draw_centered_string("OVER!");
+  gui_MarkScreenDirty();
+  gui_BlitDirtyRegions();
+
+  PaletteEffects::pulse(DARK_ORANGE, 2, (3 * TICKS_PER_SECOND) / 2);
+  PaletteEffects::fade(PALETTE_FULL_LEVEL, 0, TICKS_PER_SECOND / 4);
+  gui_DrawGameScreenBackground();
+  get_remaining_candidate(remaining_word);
+  remaining_word.copy_into_string(remaining_word_string);
+  draw_game_screen_foreground(remaining_word_string);
+  gui_MarkScreenDirty();
+  gui_BlitDirtyRegions();
+  PaletteEffects::fade(0, PALETTE_FULL_LEVEL, TICKS_PER_SECOND / 4);
+
+  return;
+}
+
+
+bool AdversarialGameplay::is_last_guess_correct() const
+{
+  if (num_guesses == 0)
+    return false;
+
+  if (word_DoesEvaluationShowAllCorrect(guess_evaluations[num_guesses - 1]))
+    return true;
+
+  return false;
+}
+
+
+bool AdversarialGameplay::are_all_guesses_used() const
+{
+  if (num_guesses == MAX_NUM_GUESSES)
+    return true;
+
+  return false;
+}
+
+
+void AdversarialGameplay::get_remaining_candidate(OUT Word& word) const
+{
+  word = dictionary[candidates[rand() % this->num_candidates]];
+  return;
+}
+
+
+pause_menu_code_t AdversarialGameplay::pause_menu() const
+{
+  const uint8_t NUM_OPTIONS = 2;
+  const char* BUTTON_TITLES[NUM_OPTIONS] = {"Resume", "Show Word"};
+
+  return Gameplay::pause_menu(BUTTON_TITLES, NUM_OPTIONS);
+}
+
+
+void AdversarialGameplay::show_help_screen() const
+{
+  const uint8_t NUM_STRINGS_ON_FIRST_PAGE = 12;
+  const char* FIRST_PAGE_STRINGS[NUM_STRINGS_ON_FIRST_PAGE] = {
+    "Gameplay:",
+    "",
+    "The rules and colors of Original apply, but",
+    "the game has not picked a target word.",
+    "",
+    "After each guess, the game colors it in the",
+    "way that rules out as few words as possible.",
+    "It only commits to a word once you leave it",
+    "no other choice.",
+    "",
+    "Narrow the dictionary down to one word and",
+    "guess it in 10 tries to win."
+  };
+  const uint8_t NUM_STRINGS_ON_SECOND_PAGE = 9;
+  const char* SECOND_PAGE_STRINGS[NUM_STRINGS_ON_SECOND_PAGE] = {
+    "Controls:",
+    "  [2nd]/[enter]  . . . . . . Enter guess",
+    "  [del]  . . . . . . . . . . . . . . . . Delete last letter",
+    "  [clear] . . . . . . . . . . . . . . Pause game",
+    "",
+    "The number of words that still fit every",
+    "guess is shown below the guesses.",
+    "",
+    "Only the last six guesses are shown."
+  };
+  const uint8_t NUM_PAGES = 2;
+
+  bool transition_in = true;
+  uint8_t page_num = 1;
+
+  while (true)
+  {
+    FrameScheduler::start_frame();
+
+    if (!transition_in && Keypad::is_idle())
+      continue;
+
+    if (Keypad::is_down_repeating(kb_KeyLeft) && page_num > 1)
+      page_num--;
+
+    if (Keypad::is_down_repeating(kb_KeyRight) && page_num < NUM_PAGES)
+      page_num++;
+
+    if (Keypad::was_released_exclusive(kb_KeyClear))
+      break;
+
+    switch (page_num)
+    {
+      case 1:
+        gui_DrawHelpScreen(FIRST_PAGE_STRINGS, NUM_STRINGS_ON_FIRST_PAGE);
+        break;
+
+      case 2:
+        gui_DrawHelpScreen(SECOND_PAGE_STRINGS, NUM_STRINGS_ON_SECOND_PAGE);
+        break;
+    };
+
+    gui_DrawPageNumberIndicator(NUM_PAGES, page_num);
+
+    if (transition_in)
+    {
+      gui_TransitionIn();
+      transition_in = false;
+    }
+    else
+    {
+      gfx_BlitBuffer();
+    }
+  }
+
+  gui_TransitionOut();
+  return;
+}
+
+
+void AdversarialGameplay::reset_guesses()
+{
+  Word empty_word;
+  num_guesses = 0;
+
+  for (uint8_t index = 0; index < MAX_NUM_GUESSES; index++)
+  {
+    guesses[index] = empty_word;
+    memset(guess_evaluations[index], UNEVALUATED, sizeof(word_evaluation_t));
+  }
+
+  this->num_candidates = dictionary.get_num_words();
+
+  for (uint24_t index = 0; index < this->num_candidates; index++)
+    candidates[index] = index;
+
+  return;
+}
+
+
+// Sizes the candidate buffers for every word in the dictionary. Returns false,
+// with nothing allocated, if there is not enough memory.
+bool AdversarialGameplay::allocate_candidates()
+{
+  const uint24_t NUM_WORDS = dictionary.get_num_words();
+
+  // Candidates are stored as 16-bit dictionary indices.
+  assert(NUM_WORDS <= UINT16_MAX + 1);
+
+  candidates = (uint16_t*)malloc(NUM_WORDS * sizeof(uint16_t));
+  candidate_patterns = (evaluation_pattern_t*)malloc(
+    NUM_WORDS * sizeof(evaluation_pattern_t)
+  );
+
+  if (candidates == NULL || candidate_patterns == NULL)
+  {
+    free_candidates();
+    return false;
+  }
+
+  return true;
+}
+
+
+void AdversarialGameplay::free_candidates()
+{
+  free(candidates);
+  free(candidate_patterns);
+  candidates = NULL;
+  candidate_patterns = NULL;
+  return;
+}
+
+
+void AdversarialGameplay::add_guess(IN word_string_t guess)
+{
+  if (num_guesses < MAX_NUM_GUESSES)
+  {
+    guesses[num_guesses] = guess;
+    word_DecodeEvaluation(
+      keep_largest_partition(guesses[num_guesses]),
+      guess_evaluations[num_guesses]
+    );
+    num_guesses++;
+  }
+
+  return;
+}
+
+
+// Partitions the candidates by the evaluation they give `guess` and keeps the
+// largest partition. Returns the evaluation pattern shared by the kept
+// candidates.
+evaluation_pattern_t AdversarialGameplay::keep_largest_partition(
+  IN Word& guess
+)
+{
+  uint16_t partition_sizes[NUM_EVALUATION_PATTERNS] = { 0 };
+  evaluation_pattern_t largest_pattern = ALL_CORRECT_PATTERN;
+  uint16_t largest_size = 0;
+  uint24_t num_kept = 0;
+
+  // One pass computes every candidate's pattern and the histogram; the
+  // patterns are kept so the compaction pass need not evaluate again.
+  for (uint24_t index = 0; index < this->num_candidates; index++)
+  {
+    candidate_patterns[index] = word_GetEvaluationPattern(
+      guess, dictionary[candidates[index]]
+    );
+    partition_sizes[candidate_patterns[index]]++;
+  }
+
+  // Ties go to the lower pattern, which reveals fewer correct letters. The
+  // all-correct partition is only chosen when it is the only one left.
+  for (
+    evaluation_pattern_t pattern = 0;
+    pattern < ALL_CORRECT_PATTERN;
+    pattern++
+  )
+  {
+    if (partition_sizes[pattern] > largest_size)
+    {
+      largest_pattern = pattern;
+      largest_size = partition_sizes[pattern];
+    }
+  }
+
+  for (uint24_t index = 0; index < this->num_candidates; index++)
+  {
+    if (candidate_patterns[index] == largest_pattern)
+    {
+      candidates[num_kept] = candidates[index];
+      num_kept++;
+    }
+  }
+
+  this->num_candidates = num_kept;
+  return largest_pattern;
+}
@@ -0,0 +1,52 @@
+#ifndef GAMEPLAY_ADVERSARIAL_H
+#define GAMEPLAY_ADVERSARIAL_H
+
+
+#include "gameplay.h"
+
+
+// ============================================================================
+// CLASS DECLARATIONS
+// ============================================================================
+
+
+// The target is never fixed. After each guess, the game keeps the largest set
+// of dictionary words that all give the guess the same evaluation, so the
+// player has to narrow the dictionary down to a single word.
+class AdversarialGameplay : public Gameplay
+{
+  public:
+    AdversarialGameplay();
+    void play_random_word();
+
+  private:
+    static const uint8_t ID = 3;
+    static const uint8_t MAX_NUM_GUESSES = 10;
+    static const uint8_t NUM_VISIBLE_GUESSES = 6;
+
+    Dictionary dictionary;
+    Word guesses[MAX_NUM_GUESSES];
+    word_evaluation_t guess_evaluations[MAX_NUM_GUESSES];
+    uint8_t num_guesses;
+    uint24_t num_candidates;
+
+    void draw_game_screen_foreground(IN word_string_t current_guess) const;
+    void draw_guesses() const;
+    void draw_num_candidates() const;
+    void draw_win_animation() const;
+    void draw_lose_animation() const;
+    bool is_last_guess_correct() const;
+    bool are_all_guesses_used() const;
+    void get_remaining_candidate(OUT Word& word) const;
+    pause_menu_code_t pause_menu() const;
+    void show_help_screen() const;
+
+    void reset_guesses();
+    bool allocate_candidates();
+    void free_candidates();
+    void add_guess(IN word_string_t guess);
+    evaluation_pattern_t keep_largest_partition(IN Word& guess);
+};
+
+
+#endif
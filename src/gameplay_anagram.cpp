@@ -5,11 +5,13 @@
 
 #include "ccdbg/ccdbg.h"
 #include "gfx/gfx.h"
+#include "framescheduler.h"
 #include "gameplay.h"
 #include "gameplay_anagram.h"
 #include "gui.h"
 #include "ingamehelp.h"
 #include "keypad.h"
+#include "paletteeffects.h"
 
 
 
@@ -147,7 +149,14 @@ void AnagramGameplay::play_random_word()
 
   while (true)
   {
-    Keypad::update_state();
+    FrameScheduler::start_frame();
+
+    if (
+      !transition_in && !full_redraw
+      && Keypad::is_idle() && scheduler.is_idle()
+      && !gui_IsNotificationShowing()
+    )
+      continue;
 
     if (Keypad::was_released_exclusive(kb_KeyMode))
     {
@@ -196,8 +205,7 @@ void AnagramGameplay::play_random_word()
       }
       else
       {
-        word_not_in_dictionary_notification();
-        full_redraw = true;
+        gui_QueueNotification("Word not in dictionary!");
       }
     }
 
@@ -207,8 +215,11 @@ void AnagramGameplay::play_random_word()
       break;
     }
 
+    if (!partial_redraw && !full_redraw)
+      scheduler.run(SCHEDULER_IDLE_FRAME_BUDGET);
+
     if (full_redraw)
-      draw_game_screen_background();
+      gui_DrawGameScreenBackground();
 
     if (partial_redraw || full_redraw)
     {
@@ -222,7 +233,8 @@ void AnagramGameplay::play_random_word()
       transition_in = false;
     }
 
-    gfx_BlitBuffer();
+    gui_MarkScreenDirty();
+    gui_BlitDirtyRegions();
     full_redraw = false;
 
     if (guess_submitted)
@@ -255,25 +267,6 @@ void AnagramGameplay::play_random_word()
 }
 
 
-void AnagramGameplay::draw_game_screen_background() const
-{
-  gui_DrawCheckeredBackground();
-
-  gfx_SetColor(WHITE);
-  gfx_VertLine(32, 0, LCD_HEIGHT);
-  gfx_VertLine(288, 0, LCD_HEIGHT);
-  gfx_SetColor(BLACK);
-  gfx_VertLine(30, 0, LCD_HEIGHT);
-  gfx_VertLine(31, 0, LCD_HEIGHT);
-  gfx_VertLine(289, 0, LCD_HEIGHT);
-  gfx_VertLine(290, 0, LCD_HEIGHT);
-
-  gfx_SetColor(DARK_MED_BLUE);
-  gfx_FillRectangle_NoClip(33, 0, 254, LCD_HEIGHT);
-  return;
-}
-
-
 static void draw_icon(
   IN char character, IN evaluation_code_t evaluation_code, IN point_t& origin
 )
@@ -345,8 +338,14 @@ void AnagramGameplay::draw_game_screen_foreground(
   GuiText text;
   word_string_t target_string;
 
-  gfx_SetColor(DARK_MED_BLUE);
-  gfx_FillRectangle_NoClip(33, 0, 254, 200);
+  rectangle_t board = {
+    .xpos = 33,
+    .ypos = 0,
+    .width = 254,
+    .height = 200
+  };
+
+  gui_RestoreBackground(board);
 
   this->target.copy_into_string(target_string);
   text.set_font(GuiText::DOUBLE_SIZE_WITH_SHADOW);
@@ -371,9 +370,9 @@ void AnagramGameplay::draw_guess_correct_animation() const
   text.set_font(GuiText::GAME_COMPLETION);
   text.set_ypos(100);
   text.draw_centered_string("CORRECT!");
-  gui_TransitionIn();
-
-  delay(1000);
+  gui_MarkScreenDirty();
+  gui_BlitDirtyRegions();
+  PaletteEffects::flash(GREEN, 2, TICKS_PER_SECOND);
   return;
 }
 
@@ -391,9 +390,9 @@ void AnagramGameplay::draw_guess_incorrect_animation() const
   text.set_font(GuiText::GAME_COMPLETION);
   text.set_ypos(100);
   text.draw_centered_string("WRONG!");
-  gui_TransitionIn();
-
-  delay(1000);
+  gui_MarkScreenDirty();
+  gui_BlitDirtyRegions();
+  PaletteEffects::pulse(DARK_ORANGE, 2, TICKS_PER_SECOND);
   return;
 }
 
@@ -473,7 +472,10 @@ void AnagramGameplay::show_help_screen() const
 
   while (true)
   {
-    Keypad::update_state();
+    FrameScheduler::start_frame();
+
+    if (!transition_in && Keypad::is_idle())
+      continue;
 
     if (Keypad::is_down_repeating(kb_KeyLeft) && page_num > 1)
       page_num--;
@@ -553,25 +555,6 @@ void AnagramGameplay::pick_next_target_word()
 }
 
 
-void AnagramGameplay::word_not_in_dictionary_notification()
-{
-  Notification notification("Word not in dictionary!");
-  notification.draw();
-
-  while (true)
-  {
-    Keypad::update_state();
-
-    if (Keypad::was_any_key_released())
-      break;
-
-    notification.blit();
-  }
-
-  return;
-}
-
-
 void AnagramGameplay::results_screen()
 {
   const uint24_t HORIZONTAL_SPACING = 5;
@@ -580,7 +563,7 @@ void AnagramGameplay::results_screen()
   );
   GuiText text;
 
-  draw_game_screen_background();
+  gui_DrawGameScreenBackground();
 
   text.set_font(GuiText::DOUBLE_SIZE_WITH_SHADOW);
   text.set_ypos(40);
@@ -27,7 +27,6 @@ class AnagramGameplay : public Gameplay
     uint8_t num_rounds_completed;
 
     void draw_guess_correctness_icons() const;
-    void draw_game_screen_background() const;
     void draw_game_screen_foreground(IN word_string_t current_guess) const;
     void draw_guess_correct_animation() const;
     void draw_guess_incorrect_animation() const;
@@ -40,7 +39,6 @@ class AnagramGameplay : public Gameplay
     void reset_guesses();
     void add_guess(IN word_string_t guess);
     void pick_next_target_word();
-    void word_not_in_dictionary_notification();
     void results_screen();
 };
 
@@ -0,0 +1,515 @@
+#include <sys/lcd.h>
+#include <sys/timers.h>
+#include <assert.h>
+#include <debug.h>
+#include <string.h>
+
+#include "gfx/gfx.h"
+#include "framescheduler.h"
+#include "gameplay_ladder.h"
+#include "gui.h"
+#include "ingamehelp.h"
+#include "keypad.h"
+#include "paletteeffects.h"
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+#define START_YPOS  (10)
+#define TARGET_YPOS (178)
+
+
+// ============================================================================
+// CLASS LadderGameplay FUNCTION DEFINITIONS
+// ============================================================================
+
+
+LadderGameplay::LadderGameplay(): Gameplay(ID)
+{
+  return;
+}
+
+
+void LadderGameplay::play_random_word()
+{
+  const pause_menu_code_t SHOW_LADDER = OPTION_TWO;
+
+  Word step;
+  word_string_t input = { '\0' };
+  char letter;
+  uint8_t num_letters = 0;
+  bool transition_in = true;
+  bool full_redraw = true;
+  uint8_t pause_menu_decision = NO_DECISION;
+
+  // The graph stores words by dictionary index, so it is only usable with the
+  // dictionary it was built for.
+  if (
+    !graph.is_loaded()
+    || graph.get_num_words() != dictionary.get_num_words()
+  )
+  {
+    gui_Notification("Ladder appvar not found!");
+    return;
+  }
+
+  if (!graph.allocate_search_buffers())
+  {
+    gui_Notification("Not enough memory!");
+    return;
+  }
+
+  if (!pick_ladder())
+  {
+    graph.free_search_buffers();
+    gui_Notification("Could not build a ladder!");
+    return;
+  }
+
+  gui_TransitionOut();
+
+  if (InGameHelp::must_show_help_for(InGameHelp::LADDER_GAMEPLAY))
+    show_help_screen();
+
+  while (true)
+  {
+    FrameScheduler::start_frame();
+
+    if (
+      !transition_in && !full_redraw && Keypad::is_idle()
+      && !gui_IsNotificationShowing()
+    )
+      continue;
+
+    if (Keypad::was_released_exclusive(kb_KeyMode))
+    {
+      gui_TransitionOut();
+      show_help_screen();
+      full_redraw = true;
+      transition_in = true;
+    }
+    else if (Keypad::was_released_exclusive(kb_KeyClear))
+    {
+      pause_menu_decision = pause_menu();
+
+      if (pause_menu_decision == QUIT_GAME)
+        break;
+      else
+        full_redraw = true;
+    }
+    else if (
+      keypad_GetUppercaseAsciiLetter(letter) && num_letters < WORD_LENGTH
+    )
+    {
+      input[num_letters] = letter;
+      num_letters++;
+    }
+    else if (Keypad::is_down_repeating(kb_KeyDel) && num_letters > 0)
+    {
+      num_letters--;
+      input[num_letters] = '\0';
+    }
+    else if (
+      Keypad::was_released_exclusive(kb_Key2nd)
+      || Keypad::was_released_exclusive(kb_KeyEnter)
+    )
+    {
+      step = input;
+
+      if (!dictionary.contains_word(step))
+      {
+        gui_QueueNotification("Not a dictionary word!");
+      }
+      else if (!is_one_letter_from_last_step(step))
+      {
+        gui_QueueNotification("Change exactly one letter!");
+      }
+      else
+      {
+        add_step(input);
+        memset(input, '\0', WORD_LENGTH);
+        num_letters = 0;
+      }
+    }
+
+    if (full_redraw)
+    {
+      gui_DrawGameScreenBackground();
+      full_redraw = false;
+    }
+
+    draw_game_screen_foreground(input);
+
+    if (transition_in)
+    {
+      gui_TransitionIn();
+      transition_in = false;
+    }
+
+    gui_MarkScreenDirty();
+    gui_BlitDirtyRegions();
+
+    if (is_target_reached())
+    {
+      draw_win_animation();
+      Keypad::block_until_any_key_released();
+      break;
+    }
+    else if (are_all_steps_used() || (pause_menu_decision == SHOW_LADDER))
+    {
+      draw_lose_animation();
+      Keypad::block_until_any_key_released();
+      break;
+    }
+  }
+
+  gui_TransitionOut();
+  graph.free_search_buffers();
+  return;
+}
+
+
+void LadderGameplay::draw_game_screen_foreground(
+  IN word_string_t current_guess
+) const
+{
+  word_evaluation_t evaluation;
+  point_t origin = {
+    .xpos = (LCD_WIDTH / 2),
+    .ypos = START_YPOS
+  };
+
+  get_target_matches(start, evaluation);
+  draw_evaluated_guess(start, evaluation, origin);
+  draw_steps(steps, num_steps);
+  draw_status();
+
+  get_target_matches(target, evaluation);
+  origin.ypos = TARGET_YPOS;
+  draw_evaluated_guess(target, evaluation, origin);
+
+  draw_word_input(current_guess);
+  return;
+}
+
+
+// Only the most recent steps fit between the start and target words.
+void LadderGameplay::draw_steps(IN Word* words, IN uint8_t num_words) const
+{
+  const uint8_t START_INDEX = (
+    num_words > NUM_VISIBLE_STEPS ? num_words - NUM_VISIBLE_STEPS : 0
+  );
+
+  GuiText text;
+  Word empty_word;
+  word_evaluation_t evaluation;
+  point_t origin = {
+    .xpos = (LCD_WIDTH / 2),
+    .ypos = START_YPOS
+  };
+
+  origin.ypos += spr_character_slot->height + 5;
+  text.set_font(GuiText::NORMAL_SIZE_WITH_SHADOW);
+
+  for (
+    uint8_t index = START_INDEX;
+    index < START_INDEX + NUM_VISIBLE_STEPS;
+    index++
+  )
+  {
+    // The numbers shift once the steps start scrolling.
+    rectangle_t number = {
+      .xpos = 70,
+      .ypos = origin.ypos,
+      .width = 30,
+      .height = spr_character_slot->height
+    };
+
+    gui_RestoreBackground(number);
+
+    if (index < num_words)
+    {
+      text.set_xpos(70);
+      text.set_ypos(origin.ypos + 7);
+      text.draw_unsigned_int(index + 1);
+      get_target_matches(words[index], evaluation);
+      draw_evaluated_guess(words[index], evaluation, origin);
+    }
+    else
+    {
+      draw_evaluated_guess(empty_word, evaluation, origin);
+    }
+
+    origin.ypos += spr_character_slot->height + 5;
+  }
+
+  return;
+}
+
+
+void LadderGameplay::draw_status() const
+{
+  const uint8_t YPOS = TARGET_YPOS - GFX_DEFAULT_FONT_HEIGHT - 8;
+
+  GuiText text;
+
+  rectangle_t line = {
+    .xpos = 33,
+    .ypos = (uint8_t)(YPOS - 2),
+    .width = 254,
+    .height = GFX_DEFAULT_FONT_HEIGHT + 4
+  };
+
+  gui_RestoreBackground(line);
+
+  text.set_font(GuiText::NORMAL_SIZE_WITH_SHADOW);
+  text.set_ypos(YPOS);
+  text.set_xpos(100);
+  text.draw_string("Par: ");
+  text.draw_unsigned_int(this->par);
+  text.set_xpos(170);
+  text.draw_string("Steps: ");
+  text.draw_unsigned_int(this->num_steps);
+  return;
+}
+
+
+void LadderGameplay::draw_win_animation() const
+{
+  const uint24_t RECTANGLE_WIDTH = 200;
+  const uint24_t RECTANGLE_XPOS = (LCD_WIDTH - RECTANGLE_WIDTH) / 2;
+
+  GuiText text;
+  word_string_t empty_string = { '\0' };
+
+  gfx_SetColor(GREEN);
+  gfx_FillRectangle_NoClip(RECTANGLE_XPOS, 0, RECTANGLE_WIDTH, LCD_HEIGHT);
+
+  text.set_font(GuiText::GAME_COMPLETION);
+  text.set_ypos(100);
+  text.draw_centered_string("YOU");
+  text.set_ypos(124);
+  text.draw_centered_string("WIN!");
+  gui_MarkScreenDirty();
+  gui_BlitDirtyRegions();
+  PaletteEffects::flash(GREEN, 3, (5 * TICKS_PER_SECOND) / 2);
+  PaletteEffects::fade(PALETTE_FULL_LEVEL, 0, TICKS_PER_SECOND / 4);
+  gui_DrawGameScreenBackground();
+  draw_game_screen_foreground(empty_string);
+  gui_MarkScreenDirty();
+  gui_BlitDirtyRegions();
+  PaletteEffects::fade(0, PALETTE_FULL_LEVEL, TICKS_PER_SECOND / 4);
+
+  return;
+}
+
+
+// Ends on a shortest ladder from the start word to the target.
+void LadderGameplay::draw_lose_animation() const
+{
+  const uint24_t RECTANGLE_WIDTH = 200;
+  const uint24_t RECTANGLE_XPOS = (LCD_WIDTH - RECTANGLE_WIDTH) / 2;
+
+  GuiText text;
+  word_string_t empty_string = { '\0' };
+  uint16_t path[MAX_LADDER_LENGTH];
+  Word path_words[MAX_LADDER_LENGTH];
+  uint8_t path_length;
+
+  gfx_SetColor(DARK_ORANGE);
+  gfx_FillRectangle_NoClip(RECTANGLE_XPOS, 0, RECTANGLE_WIDTH, LCD_HEIGHT);
+
+  text.set_font(GuiText::GAME_COMPLETION);
+  text.set_ypos(100);
+  text.draw_centered_string("GAME");
+  text.set_ypos(124);
+  text.draw_centered_string("OVER!");
+  gui_MarkScreenDirty();
+  gui_BlitDirtyRegions();
+
+  path_length = graph.get_shortest_path(start_index, target_index, path);
+
+  // The start and target words already have rows of their own.
+  for (uint8_t index = 1; index + 1 < path_length; index++)
+    path_words[index - 1] = dictionary[path[index]];
+
+  PaletteEffects::pulse(DARK_ORANGE, 2, (3 * TICKS_PER_SECOND) / 2);
+  PaletteEffects::fade(PALETTE_FULL_LEVEL, 0, TICKS_PER_SECOND / 4);
+  gui_DrawGameScreenBackground();
+  draw_game_screen_foreground(empty_string);
+  draw_steps(path_words, (path_length > 2 ? path_length - 2 : 0));
+  gui_MarkScreenDirty();
+  gui_BlitDirtyRegions();
+  PaletteEffects::fade(0, PALETTE_FULL_LEVEL, TICKS_PER_SECOND / 4);
+
+  return;
+}
+
+
+// Marks the letters that already match the target word in the same position.
+void LadderGameplay::get_target_matches(
+  IN Word& word, OUT word_evaluation_t evaluation
+) const
+{
+  for (uint8_t index = 0; index < WORD_LENGTH; index++)
+  {
+    if (word[index] == target[index])
+      evaluation[index] = POSITION_AND_LETTER_CORRECT;
+    else
+      evaluation[index] = POSITION_AND_LETTER_INCORRECT;
+  }
+
+  return;
+}
+
+
+bool LadderGameplay::is_one_letter_from_last_step(IN Word& word) const
+{
+  const Word& LAST_STEP = (num_steps > 0 ? steps[num_steps - 1] : start);
+
+  uint8_t num_changed_letters = 0;
+
+  for (uint8_t index = 0; index < WORD_LENGTH; index++)
+  {
+    if (word[index] != LAST_STEP[index])
+      num_changed_letters++;
+  }
+
+  return num_changed_letters == 1;
+}
+
+
+bool LadderGameplay::is_target_reached() const
+{
+  if (num_steps == 0)
+    return false;
+
+  if (steps[num_steps - 1] == target)
+    return true;
+
+  return false;
+}
+
+
+bool LadderGameplay::are_all_steps_used() const
+{
+  if (num_steps == MAX_NUM_STEPS)
+    return true;
+
+  return false;
+}
+
+
+pause_menu_code_t LadderGameplay::pause_menu() const
+{
+  const uint8_t NUM_OPTIONS = 2;
+  const char* BUTTON_TITLES[NUM_OPTIONS] = {"Resume", "Show Ladder"};
+
+  return Gameplay::pause_menu(BUTTON_TITLES, NUM_OPTIONS);
+}
+
+
+void LadderGameplay::show_help_screen() const
+{
+  const uint8_t NUM_STRINGS_ON_FIRST_PAGE = 11;
+  const char* FIRST_PAGE_STRINGS[NUM_STRINGS_ON_FIRST_PAGE] = {
+    "Gameplay:",
+    "",
+    "Climb from the word at the top to the word",
+    "at the bottom by changing one letter at a",
+    "time. Every step must be a dictionary word.",
+    "",
+    "Letters that already match the bottom word",
+    "are GREEN.",
+    "",
+    "Par is the fewest steps the climb can take.",
+    "Reach the bottom word in 12 steps to win."
+  };
+  const uint8_t NUM_STRINGS_ON_SECOND_PAGE = 4;
+  const char* SECOND_PAGE_STRINGS[NUM_STRINGS_ON_SECOND_PAGE] = {
+    "Controls:",
+    "  [2nd]/[enter]  . . . . . . Enter step",
+    "  [del]  . . . . . . . . . . . . . . . . Delete last letter",
+    "  [clear] . . . . . . . . . . . . . . Pause game"
+  };
+  const uint8_t NUM_PAGES = 2;
+
+  bool transition_in = true;
+  uint8_t page_num = 1;
+
+  while (true)
+  {
+    FrameScheduler::start_frame();
+
+    if (!transition_in && Keypad::is_idle())
+      continue;
+
+    if (Keypad::is_down_repeating(kb_KeyLeft) && page_num > 1)
+      page_num--;
+
+    if (Keypad::is_down_repeating(kb_KeyRight) && page_num < NUM_PAGES)
+      page_num++;
+
+    if (Keypad::was_released_exclusive(kb_KeyClear))
+      break;
+
+    switch (page_num)
+    {
+      case 1:
+        gui_DrawHelpScreen(FIRST_PAGE_STRINGS, NUM_STRINGS_ON_FIRST_PAGE);
+        break;
+
+      case 2:
+        gui_DrawHelpScreen(SECOND_PAGE_STRINGS, NUM_STRINGS_ON_SECOND_PAGE);
+        break;
+    };
+
+    gui_DrawPageNumberIndicator(NUM_PAGES, page_num);
+
+    if (transition_in)
+    {
+      gui_TransitionIn();
+      transition_in = false;
+    }
+    else
+    {
+      gfx_BlitBuffer();
+    }
+  }
+
+  gui_TransitionOut();
+  return;
+}
+
+
+bool LadderGameplay::pick_ladder()
+{
+  Word empty_word;
+
+  if (!graph.pick_random_pair(MIN_PAR, MAX_PAR, start_index, target_index, par))
+    return false;
+
+  start = dictionary[start_index];
+  target = dictionary[target_index];
+  num_steps = 0;
+
+  for (uint8_t index = 0; index < MAX_NUM_STEPS; index++)
+    steps[index] = empty_word;
+
+  return true;
+}
+
+
+void LadderGameplay::add_step(IN word_string_t step)
+{
+  if (num_steps < MAX_NUM_STEPS)
+  {
+    steps[num_steps] = step;
+    num_steps++;
+  }
+
+  return;
+}
@@ -0,0 +1,59 @@
+#ifndef GAMEPLAY_LADDER_H
+#define GAMEPLAY_LADDER_H
+
+
+#include "gameplay.h"
+#include "ladder.h"
+
+
+// ============================================================================
+// CLASS DECLARATIONS
+// ============================================================================
+
+
+// The player climbs from a start word to a target word by changing one letter
+// at a time. Every step must be a dictionary word. Start and target are picked
+// with a search of the ladder graph, which also gives the par.
+class LadderGameplay : public Gameplay
+{
+  public:
+    LadderGameplay();
+    void play_random_word();
+
+  private:
+    static const uint8_t ID = 5;
+    static const uint8_t MAX_NUM_STEPS = 12;
+    static const uint8_t NUM_VISIBLE_STEPS = 5;
+    static const uint8_t MIN_PAR = 3;
+    static const uint8_t MAX_PAR = 6;
+
+    Dictionary dictionary;
+    LadderGraph graph;
+    uint16_t start_index;
+    uint16_t target_index;
+    uint8_t par;
+    Word start;
+    Word target;
+    Word steps[MAX_NUM_STEPS];
+    uint8_t num_steps;
+
+    void draw_game_screen_foreground(IN word_string_t current_guess) const;
+    void draw_steps(IN Word* words, IN uint8_t num_words) const;
+    void draw_status() const;
+    void draw_win_animation() const;
+    void draw_lose_animation() const;
+    void get_target_matches(
+      IN Word& word, OUT word_evaluation_t evaluation
+    ) const;
+    bool is_one_letter_from_last_step(IN Word& word) const;
+    bool is_target_reached() const;
+    bool are_all_steps_used() const;
+    pause_menu_code_t pause_menu() const;
+    void show_help_screen() const;
+
+    bool pick_ladder();
+    void add_step(IN word_string_t step);
+};
+
+
+#endif
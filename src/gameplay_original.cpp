@@ -6,10 +6,13 @@
 
 #include "ccdbg/ccdbg.h"
 #include "gfx/gfx.h"
+#include "framescheduler.h"
 #include "gameplay_original.h"
 #include "gui.h"
 #include "ingamehelp.h"
 #include "keypad.h"
+#include "paletteeffects.h"
+#include "settings.h"
 
 
 // ============================================================================
@@ -22,94 +25,6 @@ static void byte_to_hex_pair(IN char character, OUT char hex_pair[2]);
 static uint8_t ascii_hex_pair_to_byte(IN char ascii_hex_pair[2]);
 
 
-// ============================================================================
-// CLASS AlphabetTracker FUNCTION DECLARATIONS
-// ============================================================================
-
-
-AlphabetTracker::AlphabetTracker()
-{
-  initialize();
-  return;
-}
-
-
-void AlphabetTracker::initialize()
-{
-  memset(letters_not_in_target, '\0', 26);
-  return;
-}
-
-
-void AlphabetTracker::include_guess(
-  IN Word& guess, IN word_evaluation_t evaluation
-)
-{
-  for (uint8_t index = 0; index < WORD_LENGTH; index++)
-  {
-    if (evaluation[index] == POSITION_AND_LETTER_INCORRECT)
-    {
-      letters_not_in_target[guess[index] - 'A'] = guess[index];
-    }
-  }
-
-  return;
-}
-
-
-void AlphabetTracker::draw() const
-{
-  const uint24_t HORIZONTAL_SPACING = 8;
-  const uint24_t LETTER_WIDTH = 8;
-  const uint8_t LETTERS_PER_LINE = 13;
-  const uint24_t LINE_WIDTH = (
-    LETTERS_PER_LINE * (LETTER_WIDTH + HORIZONTAL_SPACING)
-  ) - HORIZONTAL_SPACING;
-
-  uint24_t xpos = (LCD_WIDTH - LINE_WIDTH) / 2;
-  uint8_t ypos = 160;
-  char letter;
-
-  DecoratedRectangle rectangle;
-  GuiText text;
-
-  rectangle.set_ypos(ypos - 5);
-  rectangle.set_width(LINE_WIDTH + 30);
-  rectangle.set_height((2 * GFX_DEFAULT_FONT_HEIGHT) + 6 + 10);
-  rectangle.center_horizontally_on_screen();
-  rectangle.set_color(DARK_MED_BLUE);
-  rectangle.set_border_color(WHITE);
-  rectangle.set_border_radius(6);
-  rectangle.set_border_thickness(1);
-  rectangle.draw();
-
-  text.set_font(GuiText::DEFAULT);
-  text.set_ypos(ypos);
-
-  for (uint8_t index = 0; index < 26; index++)
-  {
-    if (index == LETTERS_PER_LINE)
-    {
-      xpos = (LCD_WIDTH - LINE_WIDTH) / 2;
-      ypos += GFX_DEFAULT_FONT_HEIGHT + 6;
-      text.set_ypos(ypos);
-    }
-
-    letter = 'A' + index;
-
-    if (letters_not_in_target[index] != letter)
-    {
-      text.set_xpos(xpos);
-      text.draw_character(letter);
-    }
-
-    xpos += (LETTER_WIDTH + HORIZONTAL_SPACING);
-  }
-
-  return;
-}
-
-
 // ============================================================================
 // CLASS OriginalGameplay FUNCTION DEFINITIONS
 // ============================================================================
@@ -161,32 +76,13 @@ void OriginalGameplay::play_valid_word_code(IN char* code)
 }
 
 
-void OriginalGameplay::draw_game_screen_background() const
-{
-  gui_DrawCheckeredBackground();
-
-  gfx_SetColor(WHITE);
-  gfx_VertLine(32, 0, LCD_HEIGHT);
-  gfx_VertLine(288, 0, LCD_HEIGHT);
-  gfx_SetColor(BLACK);
-  gfx_VertLine(30, 0, LCD_HEIGHT);
-  gfx_VertLine(31, 0, LCD_HEIGHT);
-  gfx_VertLine(289, 0, LCD_HEIGHT);
-  gfx_VertLine(290, 0, LCD_HEIGHT);
-
-  gfx_SetColor(DARK_MED_BLUE);
-  gfx_FillRectangle_NoClip(33, 0, 254, LCD_HEIGHT);
-  return;
-}
-
-
 void OriginalGameplay::draw_game_screen_foreground(
   IN word_string_t current_guess
 ) const
 {
   draw_guesses();
   draw_word_input(current_guess);
-  alphabet_tracker.draw();
+  draw_alphabet();
   return;
 }
 
@@ -211,6 +107,76 @@ void OriginalGameplay::draw_guesses() const
 }
 
 
+void OriginalGameplay::draw_alphabet() const
+{
+  const uint24_t HORIZONTAL_SPACING = 8;
+  const uint24_t LETTER_WIDTH = 8;
+  const uint8_t LETTERS_PER_LINE = 13;
+  const uint24_t LINE_WIDTH = (
+    LETTERS_PER_LINE * (LETTER_WIDTH + HORIZONTAL_SPACING)
+  ) - HORIZONTAL_SPACING;
+
+  uint24_t xpos = (LCD_WIDTH - LINE_WIDTH) / 2;
+  uint8_t ypos = 160;
+  char letter;
+
+  DecoratedRectangle rectangle;
+  GuiText text;
+
+  rectangle.set_ypos(ypos - 5);
+  rectangle.set_width(LINE_WIDTH + 30);
+  rectangle.set_height((2 * GFX_DEFAULT_FONT_HEIGHT) + 6 + 10);
+  rectangle.center_horizontally_on_screen();
+  rectangle.set_color(DARK_MED_BLUE);
+  rectangle.set_border_color(WHITE);
+  rectangle.set_border_radius(6);
+  rectangle.set_border_thickness(1);
+  rectangle.draw();
+
+  text.set_font(GuiText::DEFAULT);
+  text.set_ypos(ypos);
+
+  for (uint8_t index = 0; index < 26; index++)
+  {
+    if (index == LETTERS_PER_LINE)
+    {
+      xpos = (LCD_WIDTH - LINE_WIDTH) / 2;
+      ypos += GFX_DEFAULT_FONT_HEIGHT + 6;
+      text.set_ypos(ypos);
+    }
+
+    letter = 'A' + index;
+
+    switch (knowledge.get_letter_status(letter))
+    {
+      case KnowledgeState::PLACED:
+        text.set_color(GREEN);
+        break;
+
+      case KnowledgeState::PRESENT:
+        text.set_color(ORANGE);
+        break;
+
+      case KnowledgeState::ABSENT:
+        text.set_color(BLUE);
+        break;
+
+      case KnowledgeState::UNKNOWN:
+      default:
+        text.set_color(WHITE);
+        break;
+    }
+
+    text.set_xpos(xpos);
+    text.draw_character(letter);
+
+    xpos += (LETTER_WIDTH + HORIZONTAL_SPACING);
+  }
+
+  return;
+}
+
+
 void OriginalGameplay::draw_win_animation() const
 {
   const uint24_t RECTANGLE_WIDTH = 200;
@@ -227,13 +193,15 @@ void OriginalGameplay::draw_win_animation() const
   text.draw_centered_string("YOU");
   text.set_ypos(124);
   text.draw_centered_string("WIN!");
-  delay(1000);
-  gui_TransitionIn();
-
-  delay(1500);
-  draw_game_screen_background();
+  gui_MarkScreenDirty();
+  gui_BlitDirtyRegions();
+  PaletteEffects::flash(GREEN, 3, (5 * TICKS_PER_SECOND) / 2);
+  PaletteEffects::fade(PALETTE_FULL_LEVEL, 0, TICKS_PER_SECOND / 4);
+  gui_DrawGameScreenBackground();
   draw_game_screen_foreground(empty_string);
-  gui_TransitionIn();
+  gui_MarkScreenDirty();
+  gui_BlitDirtyRegions();
+  PaletteEffects::fade(0, PALETTE_FULL_LEVEL, TICKS_PER_SECOND / 4);
 
   return;
 }
@@ -255,13 +223,17 @@ void OriginalGameplay::draw_lose_animation() const
   text.draw_centered_string("GAME");
   text.set_ypos(124);
   text.draw_centered_string("OVER!");
-  gui_TransitionIn();
+  gui_MarkScreenDirty();
+  gui_BlitDirtyRegions();
 
-  delay(1500);
-  draw_game_screen_background();
+  PaletteEffects::pulse(DARK_ORANGE, 2, (3 * TICKS_PER_SECOND) / 2);
+  PaletteEffects::fade(PALETTE_FULL_LEVEL, 0, TICKS_PER_SECOND / 4);
+  gui_DrawGameScreenBackground();
   target.copy_into_string(target_string);
   draw_game_screen_foreground(target_string);
-  gui_TransitionIn();
+  gui_MarkScreenDirty();
+  gui_BlitDirtyRegions();
+  PaletteEffects::fade(0, PALETTE_FULL_LEVEL, TICKS_PER_SECOND / 4);
 
   return;
 }
@@ -276,7 +248,7 @@ void OriginalGameplay::draw_word_code_screen() const
     .ypos = 15
   };
 
-  draw_game_screen_background();
+  gui_DrawGameScreenBackground();
 
   for (uint8_t index = 0; index < MAX_NUM_GUESSES; index++)
   {
@@ -410,8 +382,8 @@ void OriginalGameplay::show_help_screen() const
     "  GREEN:      Letter is in the target word in",
     "                      that position.",
     "",
-    "Letters that are not in the target word",
-    "will be removed from the onscreen alphabet."
+    "The onscreen alphabet uses the same colors.",
+    "Letters not in the target word are dimmed."
   };
   const uint8_t NUM_STRINGS_ON_THIRD_PAGE = 14;
   const char* THIRD_PAGE_STRINGS[NUM_STRINGS_ON_THIRD_PAGE] = {
@@ -437,7 +409,10 @@ void OriginalGameplay::show_help_screen() const
 
   while (true)
   {
-    Keypad::update_state();
+    FrameScheduler::start_frame();
+
+    if (!transition_in && Keypad::is_idle())
+      continue;
 
     if (Keypad::is_down_repeating(kb_KeyLeft) && page_num > 1)
       page_num--;
@@ -481,26 +456,6 @@ void OriginalGameplay::show_help_screen() const
 }
 
 
-void OriginalGameplay::word_not_in_dictionary_notification() const
-{
-  Notification notification("Word not in dictionary!");
-
-  notification.draw();
-
-  while (true)
-  {
-    Keypad::update_state();
-
-    if (Keypad::was_any_key_released())
-      break;
-
-    notification.blit();
-  }
-
-  return;
-}
-
-
 void OriginalGameplay::play(IN Word& target_word)
 {
   const pause_menu_code_t SHOW_WORD = OPTION_TWO;
@@ -522,7 +477,14 @@ void OriginalGameplay::play(IN Word& target_word)
 
   while (true)
   {
-    Keypad::update_state();
+    FrameScheduler::start_frame();
+
+    if (
+      !transition_in && !full_redraw
+      && Keypad::is_idle() && scheduler.is_idle()
+      && !gui_IsNotificationShowing()
+    )
+      continue;
 
     if (Keypad::was_released_exclusive(kb_KeyMode))
     {
@@ -559,22 +521,31 @@ void OriginalGameplay::play(IN Word& target_word)
     {
       guess = input;
 
-      if (dictionary.contains_word(guess))
+      if (!dictionary.contains_word(guess))
       {
-        add_guess(input);
-        memset(input, '\0', WORD_LENGTH);
-        num_letters = 0;
+        gui_QueueNotification("Not a dictionary word!");
+      }
+      else if (
+        Settings::is_enabled(Settings::HARD_MODE)
+        && !knowledge.satisfies_hard_mode(guess)
+      )
+      {
+        gui_QueueNotification("Guess must use all hints!");
       }
       else
       {
-        gui_Notification("Not a dictionary word!");
-        full_redraw = true;
+        add_guess(input);
+        memset(input, '\0', WORD_LENGTH);
+        num_letters = 0;
       }
     }
 
+    if (!full_redraw)
+      scheduler.run(SCHEDULER_IDLE_FRAME_BUDGET);
+
     if (full_redraw)
     {
-      draw_game_screen_background();
+      gui_DrawGameScreenBackground();
       full_redraw = false;
     }
 
@@ -586,7 +557,8 @@ void OriginalGameplay::play(IN Word& target_word)
       transition_in = false;
     }
 
-    gfx_BlitBuffer();
+    gui_MarkScreenDirty();
+    gui_BlitDirtyRegions();
 
     if (is_last_guess_correct())
     {
@@ -622,7 +594,7 @@ void OriginalGameplay::reset_guesses()
     memset(guess_evaluations[index], UNEVALUATED, sizeof(word_evaluation_t));
   }
 
-  alphabet_tracker.initialize();
+  knowledge.reset();
   return;
 }
 
@@ -633,9 +605,9 @@ void OriginalGameplay::add_guess(IN word_string_t guess)
   {
     guesses[num_guesses] = guess;
     word_EvaluateFirstWordBySecondWord(
-      guess, target, guess_evaluations[num_guesses]
+      guesses[num_guesses], target, guess_evaluations[num_guesses]
     );
-    alphabet_tracker.include_guess(
+    knowledge.include_guess(
       guesses[num_guesses], guess_evaluations[num_guesses]
     );
     num_guesses++;
@@ -3,6 +3,7 @@
 
 
 #include "gameplay.h"
+#include "knowledge.h"
 
 
 // ============================================================================
@@ -10,19 +11,6 @@
 // ============================================================================
 
 
-class AlphabetTracker
-{
-  public:
-    AlphabetTracker();
-    void initialize();
-    void include_guess(IN Word& guess, IN word_evaluation_t evaluation);
-    void draw() const;
-
-  private:
-    char letters_not_in_target[26];
-};
-
-
 class OriginalGameplay : public Gameplay
 {
   public:
@@ -49,16 +37,16 @@ class OriginalGameplay : public Gameplay
       { '7', 'f', '7', '0', '4' }, { '1', '4', '3', '0', '8' }
     };
 
-    AlphabetTracker alphabet_tracker;
+    KnowledgeState knowledge;
     Dictionary dictionary;
     Word target;
     Word guesses[MAX_NUM_GUESSES];
     word_evaluation_t guess_evaluations[MAX_NUM_GUESSES];
     uint8_t num_guesses;
 
-    void draw_game_screen_background() const;
     void draw_game_screen_foreground(IN word_string_t current_guess) const;
     void draw_guesses() const;
+    void draw_alphabet() const;
     void draw_win_animation() const;
     void draw_lose_animation() const;
     void draw_word_code_screen() const;
@@ -68,7 +56,6 @@ class OriginalGameplay : public Gameplay
     void decrypt_word_code_into_word(IN char* code, OUT Word& word) const;
     pause_menu_code_t pause_menu() const;
     void show_help_screen() const;
-    void word_not_in_dictionary_notification() const;
 
     void play(IN Word& target_word);
     void reset_guesses();
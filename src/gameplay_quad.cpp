@@ -0,0 +1,553 @@
+#include <sys/lcd.h>
+#include <sys/timers.h>
+#include <assert.h>
+#include <debug.h>
+#include <string.h>
+
+#include "gfx/gfx.h"
+#include "framescheduler.h"
+#include "gameplay_quad.h"
+#include "gui.h"
+#include "ingamehelp.h"
+#include "keypad.h"
+#include "paletteeffects.h"
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+#define BOARDS_YPOS (20)
+#define BOARD_SPACING (8)
+#define ROW_SPACING (2)
+
+
+// ============================================================================
+// CLASS QuadGameplay FUNCTION DEFINITIONS
+// ============================================================================
+
+
+QuadGameplay::QuadGameplay(): Gameplay(ID)
+{
+  return;
+}
+
+
+void QuadGameplay::play_random_word()
+{
+  const pause_menu_code_t SHOW_WORDS = OPTION_TWO;
+
+  Word guess;
+  word_string_t input = { '\0' };
+  char letter;
+  uint8_t num_letters = 0;
+  bool transition_in = true;
+  bool full_redraw = true;
+  bool input_changed = false;
+  bool guess_added = false;
+  uint8_t pause_menu_decision = NO_DECISION;
+
+  gui_TransitionOut();
+  reset_guesses();
+  pick_targets();
+
+  if (InGameHelp::must_show_help_for(InGameHelp::QUAD_GAMEPLAY))
+    show_help_screen();
+
+  while (true)
+  {
+    FrameScheduler::start_frame();
+
+    if (
+      !transition_in && !full_redraw && Keypad::is_idle()
+      && !gui_IsNotificationShowing()
+    )
+      continue;
+
+    if (Keypad::was_released_exclusive(kb_KeyMode))
+    {
+      gui_TransitionOut();
+      show_help_screen();
+      full_redraw = true;
+      transition_in = true;
+    }
+    else if (Keypad::was_released_exclusive(kb_KeyClear))
+    {
+      pause_menu_decision = pause_menu();
+
+      if (pause_menu_decision == QUIT_GAME)
+        break;
+      else
+        full_redraw = true;
+    }
+    else if (
+      keypad_GetUppercaseAsciiLetter(letter) && num_letters < WORD_LENGTH
+    )
+    {
+      input[num_letters] = letter;
+      num_letters++;
+      input_changed = true;
+    }
+    else if (Keypad::is_down_repeating(kb_KeyDel) && num_letters > 0)
+    {
+      num_letters--;
+      input[num_letters] = '\0';
+      input_changed = true;
+    }
+    else if (
+      Keypad::was_released_exclusive(kb_Key2nd)
+      || Keypad::was_released_exclusive(kb_KeyEnter)
+    )
+    {
+      guess = input;
+
+      if (dictionary.contains_word(guess))
+      {
+        add_guess(input);
+        memset(input, '\0', WORD_LENGTH);
+        num_letters = 0;
+        guess_added = true;
+      }
+      else
+      {
+        gui_QueueNotification("Not a dictionary word!");
+      }
+    }
+
+    // Only the rows that changed are repainted. A keystroke touches the input
+    // row of each board, and a new guess also touches the row above it.
+    if (full_redraw)
+    {
+      gui_DrawGameScreenBackground();
+      draw_board_frames();
+      draw_boards(input);
+      draw_word_input(input);
+      full_redraw = false;
+    }
+    else if (guess_added)
+    {
+      draw_board_frames();
+      draw_board_rows(num_guesses - 1, input);
+
+      if (!are_all_guesses_used())
+        draw_board_rows(num_guesses, input);
+
+      draw_word_input(input);
+    }
+    else if (input_changed)
+    {
+      draw_board_rows(num_guesses, input);
+      draw_word_input(input);
+    }
+
+    input_changed = false;
+    guess_added = false;
+
+    if (transition_in)
+    {
+      gui_TransitionIn();
+      transition_in = false;
+    }
+
+    gui_MarkScreenDirty();
+    gui_BlitDirtyRegions();
+
+    if (are_all_boards_solved())
+    {
+      draw_win_animation();
+      Keypad::block_until_any_key_released();
+      break;
+    }
+    else if (are_all_guesses_used() || (pause_menu_decision == SHOW_WORDS))
+    {
+      draw_lose_animation();
+      Keypad::block_until_any_key_released();
+      break;
+    }
+  }
+
+  gui_TransitionOut();
+  return;
+}
+
+
+void QuadGameplay::draw_boards(IN word_string_t current_guess) const
+{
+  for (uint8_t row = 0; row < MAX_NUM_GUESSES; row++)
+    draw_board_rows(row, current_guess);
+
+  return;
+}
+
+
+// Draws the same row of every board. The current guess is shown, unevaluated,
+// in the first empty row of each unsolved board.
+void QuadGameplay::draw_board_rows(
+  IN uint8_t row, IN word_string_t current_guess
+) const
+{
+  const word_evaluation_t UNEVALUATED_EVALUATION = {
+    UNEVALUATED, UNEVALUATED, UNEVALUATED, UNEVALUATED, UNEVALUATED
+  };
+
+  Word empty_word;
+  Word current_word(current_guess);
+  point_t origin;
+
+  for (uint8_t board = 0; board < NUM_BOARDS; board++)
+  {
+    get_row_origin(board, row, origin);
+
+    if (row < num_board_guesses[board])
+    {
+      draw_compact_evaluated_guess(
+        guesses[row], guess_evaluations[row][board], origin
+      );
+    }
+    else if (row == num_guesses && !is_board_solved(board))
+    {
+      draw_compact_evaluated_guess(
+        current_word, UNEVALUATED_EVALUATION, origin
+      );
+    }
+    else
+    {
+      draw_compact_evaluated_guess(
+        empty_word, UNEVALUATED_EVALUATION, origin
+      );
+    }
+  }
+
+  return;
+}
+
+
+void QuadGameplay::draw_board_frames() const
+{
+  const uint24_t BOARD_WIDTH = (
+    (WORD_LENGTH * (COMPACT_TILE_SIZE + COMPACT_TILE_SPACING))
+    - COMPACT_TILE_SPACING
+  );
+  const uint8_t BOARD_HEIGHT = (
+    (MAX_NUM_GUESSES * (COMPACT_TILE_SIZE + ROW_SPACING)) - ROW_SPACING
+  );
+
+  point_t origin;
+
+  for (uint8_t board = 0; board < NUM_BOARDS; board++)
+  {
+    get_row_origin(board, 0, origin);
+
+    if (is_board_solved(board))
+      gfx_SetColor(GREEN);
+    else
+      gfx_SetColor(BLACK);
+
+    gfx_Rectangle_NoClip(
+      origin.xpos - (BOARD_WIDTH / 2) - 3,
+      origin.ypos - 3,
+      BOARD_WIDTH + 6,
+      BOARD_HEIGHT + 6
+    );
+  }
+
+  return;
+}
+
+
+// Shows the targets of the unsolved boards below their boards.
+void QuadGameplay::draw_targets() const
+{
+  GuiText text;
+  word_string_t target_string;
+  char buffer[WORD_LENGTH + 1] = { '\0' };
+  point_t origin;
+
+  text.set_font(GuiText::NORMAL_SIZE_WITH_SHADOW);
+
+  for (uint8_t board = 0; board < NUM_BOARDS; board++)
+  {
+    if (is_board_solved(board))
+      continue;
+
+    get_row_origin(board, MAX_NUM_GUESSES, origin);
+    targets[board].copy_into_string(target_string);
+    memcpy(buffer, target_string, WORD_LENGTH);
+
+    text.set_xpos(origin.xpos - (gfx_GetStringWidth(buffer) / 2));
+    text.set_ypos(origin.ypos + 6);
+    text.draw_string(buffer);
+  }
+
+  return;
+}
+
+
+void QuadGameplay::draw_win_animation() const
+{
+  const uint24_t RECTANGLE_WIDTH = 200;
+  const uint24_t RECTANGLE_XPOS = (LCD_WIDTH - RECTANGLE_WIDTH) / 2;
+
+  GuiText text;
+  word_string_t empty_string = { '\0' };
+
+  gfx_SetColor(GREEN);
+  gfx_FillRectangle_NoClip(RECTANGLE_XPOS, 0, RECTANGLE_WIDTH, LCD_HEIGHT);
+
+  text.set_font(GuiText::GAME_COMPLETION);
+  text.set_ypos(100);
+  text.draw_centered_string("YOU");
+  text.set_ypos(124);
+  text.draw_centered_string("WIN!");
+  gui_MarkScreenDirty();
+  gui_BlitDirtyRegions();
+  PaletteEffects::flash(GREEN, 3, (5 * TICKS_PER_SECOND) / 2);
+  PaletteEffects::fade(PALETTE_FULL_LEVEL, 0, TICKS_PER_SECOND / 4);
+  gui_DrawGameScreenBackground();
+  draw_board_frames();
+  draw_boards(empty_string);
+  draw_word_input(empty_string);
+  gui_MarkScreenDirty();
+  gui_BlitDirtyRegions();
+  PaletteEffects::fade(0, PALETTE_FULL_LEVEL, TICKS_PER_SECOND / 4);
+
+  return;
+}
+
+
+void QuadGameplay::draw_lose_animation() const
+{
+  const uint24_t RECTANGLE_WIDTH = 200;
+  const uint24_t RECTANGLE_XPOS = (LCD_WIDTH - RECTANGLE_WIDTH) / 2;
+
+  GuiText text;
+  word_string_t empty_string = { '\0' };
+
+  gfx_SetColor(DARK_ORANGE);
+  gfx_FillRectangle_NoClip(RECTANGLE_XPOS, 0, RECTANGLE_WIDTH, LCD_HEIGHT);
+
+  text.set_font(GuiText::GAME_COMPLETION);
+  text.set_ypos(100);
+  text.draw_centered_string("GAME");
+  text.set_ypos(124);
+  text.draw_centered_string("OVER!");
+  gui_MarkScreenDirty();
+  gui_BlitDirtyRegions();
+
+  PaletteEffects::pulse(DARK_ORANGE, 2, (3 * TICKS_PER_SECOND) / 2);
+  PaletteEffects::fade(PALETTE_FULL_LEVEL, 0, TICKS_PER_SECOND / 4);
+  gui_DrawGameScreenBackground();
+  draw_board_frames();
+  draw_boards(empty_string);
+  draw_targets();
+  draw_word_input(empty_string);
+  gui_MarkScreenDirty();
+  gui_BlitDirtyRegions();
+  PaletteEffects::fade(0, PALETTE_FULL_LEVEL, TICKS_PER_SECOND / 4);
+
+  return;
+}
+
+
+void QuadGameplay::get_row_origin(
+  IN uint8_t board, IN uint8_t row, OUT point_t& origin
+) const
+{
+  const uint24_t BOARD_WIDTH = (
+    (WORD_LENGTH * (COMPACT_TILE_SIZE + COMPACT_TILE_SPACING))
+    - COMPACT_TILE_SPACING
+  );
+  const uint24_t BOARDS_WIDTH = (
+    (NUM_BOARDS * (BOARD_WIDTH + BOARD_SPACING)) - BOARD_SPACING
+  );
+
+  origin.xpos = (
+    ((LCD_WIDTH - BOARDS_WIDTH) / 2)
+    + (board * (BOARD_WIDTH + BOARD_SPACING))
+    + (BOARD_WIDTH / 2)
+  );
+  origin.ypos = BOARDS_YPOS + (row * (COMPACT_TILE_SIZE + ROW_SPACING));
+  return;
+}
+
+
+bool QuadGameplay::is_board_solved(IN uint8_t board) const
+{
+  const uint8_t LAST_ROW = num_board_guesses[board];
+
+  if (LAST_ROW == 0)
+    return false;
+
+  if (word_DoesEvaluationShowAllCorrect(guess_evaluations[LAST_ROW - 1][board]))
+    return true;
+
+  return false;
+}
+
+
+bool QuadGameplay::are_all_boards_solved() const
+{
+  for (uint8_t board = 0; board < NUM_BOARDS; board++)
+  {
+    if (!is_board_solved(board))
+      return false;
+  }
+
+  return true;
+}
+
+
+bool QuadGameplay::are_all_guesses_used() const
+{
+  if (num_guesses == MAX_NUM_GUESSES)
+    return true;
+
+  return false;
+}
+
+
+pause_menu_code_t QuadGameplay::pause_menu() const
+{
+  const uint8_t NUM_OPTIONS = 2;
+  const char* BUTTON_TITLES[NUM_OPTIONS] = {"Resume", "Show Words"};
+
+  return Gameplay::pause_menu(BUTTON_TITLES, NUM_OPTIONS);
+}
+
+
+void QuadGameplay::show_help_screen() const
+{
+  const uint8_t NUM_STRINGS_ON_FIRST_PAGE = 11;
+  const char* FIRST_PAGE_STRINGS[NUM_STRINGS_ON_FIRST_PAGE] = {
+    "Gameplay:",
+    "",
+    "Guess four target words at once. Every",
+    "guess is entered on all four boards and",
+    "colored separately for each board's target.",
+    "",
+    "A board stops taking guesses once its",
+    "target has been found.",
+    "",
+    "Find all four targets in 9 guesses to win.",
+    "The colors are the same as in Original."
+  };
+  const uint8_t NUM_STRINGS_ON_SECOND_PAGE = 4;
+  const char* SECOND_PAGE_STRINGS[NUM_STRINGS_ON_SECOND_PAGE] = {
+    "Controls:",
+    "  [2nd]/[enter]  . . . . . . Enter guess",
+    "  [del]  . . . . . . . . . . . . . . . . Delete last letter",
+    "  [clear] . . . . . . . . . . . . . . Pause game"
+  };
+  const uint8_t NUM_PAGES = 2;
+
+  bool transition_in = true;
+  uint8_t page_num = 1;
+
+  while (true)
+  {
+    FrameScheduler::start_frame();
+
+    if (!transition_in && Keypad::is_idle())
+      continue;
+
+    if (Keypad::is_down_repeating(kb_KeyLeft) && page_num > 1)
+      page_num--;
+
+    if (Keypad::is_down_repeating(kb_KeyRight) && page_num < NUM_PAGES)
+      page_num++;
+
+    if (Keypad::was_released_exclusive(kb_KeyClear))
+      break;
+
+    switch (page_num)
+    {
+      case 1:
+        gui_DrawHelpScreen(FIRST_PAGE_STRINGS, NUM_STRINGS_ON_FIRST_PAGE);
+        break;
+
+      case 2:
+        gui_DrawHelpScreen(SECOND_PAGE_STRINGS, NUM_STRINGS_ON_SECOND_PAGE);
+        break;
+    };
+
+    gui_DrawPageNumberIndicator(NUM_PAGES, page_num);
+
+    if (transition_in)
+    {
+      gui_TransitionIn();
+      transition_in = false;
+    }
+    else
+    {
+      gfx_BlitBuffer();
+    }
+  }
+
+  gui_TransitionOut();
+  return;
+}
+
+
+void QuadGameplay::pick_targets()
+{
+  bool is_repeat;
+
+  for (uint8_t board = 0; board < NUM_BOARDS; board++)
+  {
+    do {
+      dictionary.get_random_word(targets[board]);
+      is_repeat = false;
+
+      for (uint8_t other_board = 0; other_board < board; other_board++)
+      {
+        if (targets[other_board] == targets[board])
+          is_repeat = true;
+      }
+    } while (is_repeat);
+  }
+
+  return;
+}
+
+
+void QuadGameplay::reset_guesses()
+{
+  Word empty_word;
+  num_guesses = 0;
+
+  for (uint8_t index = 0; index < MAX_NUM_GUESSES; index++)
+  {
+    guesses[index] = empty_word;
+    memset(
+      guess_evaluations[index], UNEVALUATED, sizeof guess_evaluations[index]
+    );
+  }
+
+  memset(num_board_guesses, 0, NUM_BOARDS);
+  return;
+}
+
+
+// The guess is evaluated against all four targets in one batch. Solved boards
+// keep their last row.
+void QuadGameplay::add_guess(IN word_string_t guess)
+{
+  if (num_guesses < MAX_NUM_GUESSES)
+  {
+    guesses[num_guesses] = guess;
+    word_EvaluateGuessAgainstTargets(
+      guesses[num_guesses], targets, NUM_BOARDS, guess_evaluations[num_guesses]
+    );
+
+    for (uint8_t board = 0; board < NUM_BOARDS; board++)
+    {
+      if (!is_board_solved(board))
+        num_board_guesses[board]++;
+    }
+
+    num_guesses++;
+  }
+
+  return;
+}
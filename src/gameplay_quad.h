@@ -0,0 +1,54 @@
+#ifndef GAMEPLAY_QUAD_H
+#define GAMEPLAY_QUAD_H
+
+
+#include "gameplay.h"
+
+
+// ============================================================================
+// CLASS DECLARATIONS
+// ============================================================================
+
+
+// Every guess is evaluated against four targets at once, one per board. A
+// board stops taking guesses once its target is found.
+class QuadGameplay : public Gameplay
+{
+  public:
+    QuadGameplay();
+    void play_random_word();
+
+  private:
+    static const uint8_t ID = 4;
+    static const uint8_t NUM_BOARDS = 4;
+    static const uint8_t MAX_NUM_GUESSES = 9;
+
+    Dictionary dictionary;
+    Word targets[NUM_BOARDS];
+    Word guesses[MAX_NUM_GUESSES];
+    word_evaluation_t guess_evaluations[MAX_NUM_GUESSES][NUM_BOARDS];
+    uint8_t num_guesses;
+    uint8_t num_board_guesses[NUM_BOARDS];
+
+    void draw_boards(IN word_string_t current_guess) const;
+    void draw_board_rows(IN uint8_t row, IN word_string_t current_guess) const;
+    void draw_board_frames() const;
+    void draw_targets() const;
+    void draw_win_animation() const;
+    void draw_lose_animation() const;
+    void get_row_origin(
+      IN uint8_t board, IN uint8_t row, OUT point_t& origin
+    ) const;
+    bool is_board_solved(IN uint8_t board) const;
+    bool are_all_boards_solved() const;
+    bool are_all_guesses_used() const;
+    pause_menu_code_t pause_menu() const;
+    void show_help_screen() const;
+
+    void pick_targets();
+    void reset_guesses();
+    void add_guess(IN word_string_t guess);
+};
+
+
+#endif
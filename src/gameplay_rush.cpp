@@ -1,17 +1,56 @@
 #include <sys/lcd.h>
 #include <sys/timers.h>
 #include <assert.h>
-#include <debug.h>
 #include <string.h>
 #include <time.h>
 
 #include "ccdbg/ccdbg.h"
 #include "gfx/gfx.h"
+#include "framescheduler.h"
 #include "gameplay_rush.h"
 #include "graphx.h"
 #include "gui.h"
 #include "ingamehelp.h"
 #include "keypad.h"
+#include "paletteeffects.h"
+#include "settings.h"
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+// Each guess row is a 20 pixel tile, its shadow, and some spacing. The guess
+// list window covers the guess numbers and tiles of the visible rows, but not
+// the panel edges or the scroll bar.
+#define GUESS_LIST_YPOS    (15)
+#define GUESS_ROW_HEIGHT   (25)
+#define GUESS_WINDOW_XPOS  (80)
+#define GUESS_WINDOW_WIDTH (138)
+
+// The guess list scrolls by this many pixels per frame for every row it still
+// has to go, so that holding a key down never leaves it far behind.
+#define SCROLL_STEP_PIXELS (5)
+
+// The row that a scroll brings into view, drawn once and then copied into the
+// window a few scanlines at a time, and room to save the part of the window
+// that it is drawn over.
+static uint8_t incoming_guess_row[2 + (GUESS_WINDOW_WIDTH * GUESS_ROW_HEIGHT)];
+static uint8_t saved_guess_row[2 + (GUESS_WINDOW_WIDTH * GUESS_ROW_HEIGHT)];
+
+// Set to 1 to show how many bytes the last frame blitted in the bottom left
+// corner of the game screen. The readout is drawn and blitted with the rest
+// of the frame, so it adds a few hundred bytes of its own.
+#define SHOW_NUM_BYTES_BLITTED (0)
+
+
+// ============================================================================
+// STATIC FUNCTION DECLARATIONS
+// ============================================================================
+
+
+static void draw_num_bytes_blitted();
 
 
 // ============================================================================
@@ -26,30 +65,51 @@ Timer::Timer()
 }
 
 
-void Timer::update()
+// Every second is counted from the deadline of the one before, so a countdown
+// takes exactly RELOAD_VALUE seconds however late each update comes. Returns
+// true if the number of seconds left has changed.
+bool Timer::update()
 {
-  clock_t timestamp = clock();
+  bool has_changed = false;
 
-  if ((timestamp - this->start_timestamp) > CLOCKS_PER_SEC)
+  while (
+    this->num_seconds_left > 0
+    && SystemClock::has_passed(this->next_second_deadline)
+  )
   {
-    if (this->num_seconds_left > 0)
-      this->num_seconds_left--;
-
-    this->start_timestamp = timestamp;
+    this->num_seconds_left--;
+    this->next_second_deadline += TICKS_PER_SECOND;
+    has_changed = true;
   }
 
-  return;
+  return has_changed;
 }
 
 
 void Timer::reload()
 {
-  this->start_timestamp = clock();
+  this->next_second_deadline = SystemClock::now() + TICKS_PER_SECOND;
   this->num_seconds_left = RELOAD_VALUE;
   return;
 }
 
 
+// Screens that block the game loop, such as the help screen and the pause
+// menu, are wrapped in these so that the time they are open does not count.
+void Timer::freeze_updates()
+{
+  this->freeze_timestamp = SystemClock::now();
+  return;
+}
+
+
+void Timer::thaw_updates()
+{
+  this->next_second_deadline += SystemClock::now() - this->freeze_timestamp;
+  return;
+}
+
+
 bool Timer::is_expired() const
 {
   return (this->num_seconds_left == 0);
@@ -70,8 +130,8 @@ void Timer::draw() const
   container.draw();
 
   text.set_font(GuiText::NORMAL_SIZE_WITH_SHADOW);
-  text.set_xpos(container.get_xpos() + 6);
-  text.set_ypos(container.get_ypos() + 5);
+  text.set_xpos(container.get_xpos() + 7);
+  text.set_ypos(container.get_ypos() + 6);
   text.draw_unsigned_int(this->num_seconds_left);
 
   gfx_TransparentSprite_NoClip(
@@ -80,15 +140,102 @@ void Timer::draw() const
     this->YPOS - 3
   );
 
+  // The container and the icon, which sticks out above and to the right.
+  rectangle_t region = {
+    .xpos = this->XPOS,
+    .ypos = (uint8_t)(this->YPOS - 3),
+    .width = this->WIDTH + 2,
+    .height = (uint8_t)(this->HEIGHT + 5)
+  };
+
+  gui_MarkDirty(region);
+  return;
+}
+
+
+// ============================================================================
+// CLASS TargetSearch FUNCTION DEFINITIONS
+// ============================================================================
+
+
+TargetSearch::TargetSearch(
+  IN Dictionary& dictionary,
+  IN CompiledWordPattern* excluded_patterns,
+  IN uint8_t num_excluded_patterns
+): dictionary(dictionary)
+{
+  this->excluded_patterns = excluded_patterns;
+  this->num_excluded_patterns = num_excluded_patterns;
+  memset(this->green_letters, '\0', WORD_LENGTH);
+  this->is_relaxed = false;
   return;
 }
 
 
-void Timer::blit() const
+// `green_letters` holds '\0' wherever the last guess had no green letter.
+void TargetSearch::start(IN word_string_t green_letters)
 {
-  gfx_BlitRectangle(
-    gfx_buffer, this->XPOS, this->YPOS - 3, this->WIDTH + 2, this->HEIGHT + 5
-  );
+  memcpy(this->green_letters, green_letters, WORD_LENGTH);
+  this->is_relaxed = false;
+  start_sampler();
+  return;
+}
+
+
+bool TargetSearch::step()
+{
+  Word word;
+
+  if (!sampler.step(NUM_WORDS_PER_STEP))
+    return false;
+
+  if (sampler.get_word(word) || is_relaxed)
+    return true;
+
+  // The old target fits the green letters, so the relaxed search cannot fail.
+  is_relaxed = true;
+  start_sampler();
+  return false;
+}
+
+
+// Runs whatever is left of the search at once.
+void TargetSearch::finish(OUT Word& target)
+{
+  while (!step())
+    ;
+
+  sampler.get_word(target);
+  return;
+}
+
+
+void TargetSearch::start_sampler()
+{
+  CompiledWordPattern pattern;
+
+  // Plurals are too easy to guess, so the new target may only end in S if the
+  // S is carried over from the last guess.
+  if (!is_relaxed)
+    pattern.compile("****[^S]");
+
+  for (uint8_t index = 0; index < WORD_LENGTH; index++)
+  {
+    if (green_letters[index] != '\0')
+      pattern.set_letter(index, green_letters[index]);
+  }
+
+  if (is_relaxed)
+  {
+    sampler.start(dictionary, pattern, NULL, 0);
+  }
+  else
+  {
+    sampler.start(
+      dictionary, pattern, excluded_patterns, num_excluded_patterns
+    );
+  }
+
   return;
 }
 
@@ -98,8 +245,18 @@ void Timer::blit() const
 // ============================================================================
 
 
-RushGameplay::RushGameplay(): Gameplay(ID)
+RushGameplay::RushGameplay():
+  Gameplay(ID),
+  next_target_search(dictionary, excluded_patterns, NUM_EXCLUDED_PATTERNS)
 {
+  // Target words that have too many rhymes to be guessed in time.
+  const char* EXCLUDED_PATTERN_STRINGS[NUM_EXCLUDED_PATTERNS] = {
+    "*OUND", "*OO**"
+  };
+
+  for (uint8_t index = 0; index < NUM_EXCLUDED_PATTERNS; index++)
+    excluded_patterns[index].compile(EXCLUDED_PATTERN_STRINGS[index]);
+
   return;
 }
 
@@ -115,31 +272,47 @@ void RushGameplay::play_random_word()
   bool transition_in = true;
   bool full_redraw = true;
   bool partial_redraw = false;
+  bool has_timer_changed;
   uint8_t pause_menu_decision = NO_DECISION;
 
   gui_TransitionOut();
   reset_guesses();
   scroll_to_guess_list_start();
-  this->timer.reload();
   swap_target_word();
 
   if (InGameHelp::must_show_help_for(InGameHelp::RUSH_GAMEPLAY))
     show_help_screen();
 
+  this->timer.reload();
+
   while (true)
   {
-    Keypad::update_state();
+    FrameScheduler::start_frame();
+    has_timer_changed = this->timer.update();
+
+    // Apart from key presses, only the timer and the next target search need
+    // a frame.
+    if (
+      !transition_in && !full_redraw && !has_timer_changed
+      && Keypad::is_idle() && scheduler.is_idle()
+      && !is_guess_list_scrolling() && !gui_IsNotificationShowing()
+    )
+      continue;
 
     if (Keypad::was_released_exclusive(kb_KeyMode))
     {
+      this->timer.freeze_updates();
       gui_TransitionOut();
       show_help_screen();
+      this->timer.thaw_updates();
       full_redraw = true;
       transition_in = true;
     }
     else if (Keypad::was_released_exclusive(kb_KeyClear))
     {
+      this->timer.freeze_updates();
       pause_menu_decision = pause_menu();
+      this->timer.thaw_updates();
 
       if (pause_menu_decision == QUIT_GAME)
         break;
@@ -163,12 +336,10 @@ void RushGameplay::play_random_word()
     else if (Keypad::is_down_repeating(kb_KeyUp))
     {
       scroll_guess_list_up();
-      partial_redraw = true;
     }
     else if (Keypad::is_down_repeating(kb_KeyDown))
     {
       scroll_guess_list_down();
-      partial_redraw = true;
     }
     else if (
       Keypad::was_released_exclusive(kb_Key2nd)
@@ -177,23 +348,34 @@ void RushGameplay::play_random_word()
     {
       guess = input;
 
-      if (dictionary.contains_word(guess))
+      if (!dictionary.contains_word(guess))
       {
-        add_guess(input);
-        memset(input, '\0', WORD_LENGTH);
-        num_letters = 0;
+        gui_QueueNotification("Word not in dictionary!");
+        partial_redraw = true;
+      }
+      else if (
+        Settings::is_enabled(Settings::HARD_MODE)
+        && !knowledge.satisfies_hard_mode(guess)
+      )
+      {
+        gui_QueueNotification("Guess must use all hints!");
         partial_redraw = true;
       }
       else
       {
-        word_not_in_dictionary_notification();
-        full_redraw = true;
+        add_guess(input);
+        memset(input, '\0', WORD_LENGTH);
+        num_letters = 0;
+        partial_redraw = true;
       }
 
       scroll_to_guess_list_end();
     }
 
-    this->timer.update();
+    // Frames with nothing to redraw look for the next target ahead of time, so
+    // that swapping targets does not hold up the timer.
+    if (!partial_redraw && !full_redraw)
+      scheduler.run(SCHEDULER_IDLE_FRAME_BUDGET);
 
     if (this->timer.is_expired())
     {
@@ -202,13 +384,18 @@ void RushGameplay::play_random_word()
     }
 
     if (full_redraw)
-      draw_game_screen_background();
+      gui_DrawGameScreenBackground();
 
     if (partial_redraw || full_redraw)
     {
+      stop_guess_list_scroll();
       draw_game_screen_foreground(input);
       partial_redraw = false;
     }
+    else if (is_guess_list_scrolling())
+    {
+      step_guess_list_scroll();
+    }
 
     this->timer.draw();
 
@@ -218,7 +405,12 @@ void RushGameplay::play_random_word()
       transition_in = false;
     }
 
-    gfx_BlitBuffer();
+    if (SHOW_NUM_BYTES_BLITTED)
+      draw_num_bytes_blitted();
+
+    // Most frames only change the timer or the input field, so only the
+    // regions that were drawn to are copied to the screen.
+    gui_BlitDirtyRegions();
     full_redraw = false;
 
     if (is_last_guess_correct())
@@ -241,25 +433,6 @@ void RushGameplay::play_random_word()
 }
 
 
-void RushGameplay::draw_game_screen_background() const
-{
-  gui_DrawCheckeredBackground();
-
-  gfx_SetColor(WHITE);
-  gfx_VertLine(32, 0, LCD_HEIGHT);
-  gfx_VertLine(288, 0, LCD_HEIGHT);
-  gfx_SetColor(BLACK);
-  gfx_VertLine(30, 0, LCD_HEIGHT);
-  gfx_VertLine(31, 0, LCD_HEIGHT);
-  gfx_VertLine(289, 0, LCD_HEIGHT);
-  gfx_VertLine(290, 0, LCD_HEIGHT);
-
-  gfx_SetColor(DARK_MED_BLUE);
-  gfx_FillRectangle_NoClip(33, 0, 254, LCD_HEIGHT);
-  return;
-}
-
-
 void RushGameplay::draw_game_screen_foreground(
   IN word_string_t current_guess
 ) const
@@ -273,36 +446,48 @@ void RushGameplay::draw_game_screen_foreground(
 
 void RushGameplay::draw_guesses() const
 {
-  const uint8_t VERTICAL_SPACING = (spr_character_slot->height + 5);
   const uint8_t START_INDEX = this->scroll_index;
   const uint8_t UPPER_LIMIT = START_INDEX + NUM_VISIBLE_GUESSES;
 
-  GuiText text;
-  point_t origin = {
-    .xpos = (LCD_WIDTH / 2),
-    .ypos = 15
+  uint8_t ypos = GUESS_LIST_YPOS;
+  rectangle_t guess_list = {
+    .xpos = 33,
+    .ypos = 0,
+    .width = 254,
+    .height = 200
   };
 
-  gfx_SetColor(DARK_MED_BLUE);
-  gfx_FillRectangle_NoClip(33, 0, 254, 200);
+  gui_RestoreBackground(guess_list);
 
   for (uint8_t index = START_INDEX; index < UPPER_LIMIT; index++)
   {
-    if (index < this->num_guesses)
-    {
-      text.set_font(GuiText::NORMAL_SIZE_WITH_SHADOW);
-      text.set_xpos(83);
-      text.set_ypos(origin.ypos + 7);
-      text.draw_unsigned_int(index + 1);
-    }
+    draw_guess(index, ypos);
+    ypos += GUESS_ROW_HEIGHT;
+  }
+
+  return;
+}
 
-    draw_evaluated_guess(
-      guesses[index], guess_evaluations[index], origin
-    );
 
-    origin.ypos += VERTICAL_SPACING;
+// Draws the guess with its number, or empty slots if there is no such guess
+// yet, over whatever is in its row.
+void RushGameplay::draw_guess(IN uint8_t index, IN uint8_t ypos) const
+{
+  GuiText text;
+  point_t origin = {
+    .xpos = (LCD_WIDTH / 2),
+    .ypos = ypos
+  };
+
+  if (index < this->num_guesses)
+  {
+    text.set_font(GuiText::NORMAL_SIZE_WITH_SHADOW);
+    text.set_xpos(83);
+    text.set_ypos(ypos + 7);
+    text.draw_unsigned_int(index + 1);
   }
 
+  draw_evaluated_guess(guesses[index], guess_evaluations[index], origin);
   return;
 }
 
@@ -375,13 +560,15 @@ void RushGameplay::draw_win_animation() const
   text.draw_centered_string("YOU");
   text.set_ypos(124);
   text.draw_centered_string("WIN!");
-  delay(1000);
-  gui_TransitionIn();
-
-  delay(1500);
-  draw_game_screen_background();
+  gui_MarkScreenDirty();
+  gui_BlitDirtyRegions();
+  PaletteEffects::flash(GREEN, 3, (5 * TICKS_PER_SECOND) / 2);
+  PaletteEffects::fade(PALETTE_FULL_LEVEL, 0, TICKS_PER_SECOND / 4);
+  gui_DrawGameScreenBackground();
   draw_game_screen_foreground(empty_string);
-  gui_TransitionIn();
+  gui_MarkScreenDirty();
+  gui_BlitDirtyRegions();
+  PaletteEffects::fade(0, PALETTE_FULL_LEVEL, TICKS_PER_SECOND / 4);
 
   return;
 }
@@ -403,13 +590,17 @@ void RushGameplay::draw_lose_animation() const
   text.draw_centered_string("GAME");
   text.set_ypos(124);
   text.draw_centered_string("OVER!");
-  gui_TransitionIn();
+  gui_MarkScreenDirty();
+  gui_BlitDirtyRegions();
 
-  delay(1500);
-  draw_game_screen_background();
+  PaletteEffects::pulse(DARK_ORANGE, 2, (3 * TICKS_PER_SECOND) / 2);
+  PaletteEffects::fade(PALETTE_FULL_LEVEL, 0, TICKS_PER_SECOND / 4);
+  gui_DrawGameScreenBackground();
   target.copy_into_string(target_string);
   draw_game_screen_foreground(target_string);
-  gui_TransitionIn();
+  gui_MarkScreenDirty();
+  gui_BlitDirtyRegions();
+  PaletteEffects::fade(0, PALETTE_FULL_LEVEL, TICKS_PER_SECOND / 4);
 
   return;
 }
@@ -436,29 +627,6 @@ bool RushGameplay::are_all_guesses_used() const
 }
 
 
-bool RushGameplay::does_word_match_excluded_patterns(IN Word& word) const
-{
-  const uint8_t NUM_EXCLUDED_PATTERNS = 3;
-  const word_string_t EXCLUDED_PATTERNS[NUM_EXCLUDED_PATTERNS] = {
-    { '*', 'O', 'U', 'N', 'D' },
-    { '*', 'O', 'O', '*', '*' },
-    { '*', '*', '*', '*', 'S' }
-  };
-
-  WordPattern excluded_pattern;
-
-  for (uint8_t index = 0; index < NUM_EXCLUDED_PATTERNS; index++)
-  {
-    excluded_pattern.set_pattern(EXCLUDED_PATTERNS[index]);
-
-    if (excluded_pattern.matches_word(word))
-      return true;
-  }
-
-  return false;
-}
-
-
 pause_menu_code_t RushGameplay::pause_menu() const
 {
   const uint8_t NUM_OPTIONS = 2;
@@ -533,7 +701,10 @@ void RushGameplay::show_help_screen() const
 
   while (true)
   {
-    Keypad::update_state();
+    FrameScheduler::start_frame();
+
+    if (!transition_in && Keypad::is_idle())
+      continue;
 
     if (Keypad::is_down_repeating(kb_KeyLeft) && page_num > 1)
       page_num--;
@@ -592,88 +763,88 @@ void RushGameplay::reset_guesses()
     memset(guess_evaluations[index], UNEVALUATED, sizeof(word_evaluation_t));
   }
 
+  knowledge.reset();
+
+  memset(next_target_green_letters, '\0', WORD_LENGTH);
+  next_target_search.start(next_target_green_letters);
+  scheduler.add(&next_target_search);
   return;
 }
 
 
 void RushGameplay::add_guess(IN word_string_t guess)
 {
+  word_string_t green_letters;
+
   if (num_guesses < MAX_NUM_GUESSES)
   {
     guesses[num_guesses] = guess;
     word_EvaluateFirstWordBySecondWord(
-      guess, target, guess_evaluations[num_guesses]
+      guesses[num_guesses], target, guess_evaluations[num_guesses]
     );
-    num_guesses++;
-  }
-
-  return;
-}
-
-
-void RushGameplay::swap_target_word()
-{
-  assert(this->num_guesses >= 0);
-
-  WordPattern pattern;
-  word_string_t pattern_string;
-  word_evaluation_t evaluation = {
-    UNEVALUATED, UNEVALUATED, UNEVALUATED, UNEVALUATED, UNEVALUATED
-  };
-
-  if (this->num_guesses > 0)
-  {
-    memcpy(
-      evaluation,
-      this->guess_evaluations[this->num_guesses - 1],
-      WORD_LENGTH
+    knowledge.include_guess(
+      guesses[num_guesses], guess_evaluations[num_guesses]
     );
-  }
 
-  target.copy_into_string(pattern_string);
-
-  for (uint8_t index = 0; index < WORD_LENGTH; index++)
-  {
-    if (evaluation[index] != POSITION_AND_LETTER_CORRECT)
-      pattern_string[index] = WordPattern::WILDCARD_CHARACTER;
-  }
+    for (uint8_t index = 0; index < WORD_LENGTH; index++)
+    {
+      if (
+        guess_evaluations[num_guesses][index] == POSITION_AND_LETTER_CORRECT
+      )
+      {
+        green_letters[index] = guess[index];
+      }
+      else
+      {
+        green_letters[index] = '\0';
+      }
+    }
 
-  pattern.set_pattern(pattern_string);
+    num_guesses++;
 
-  do {
-    dictionary.get_random_word_that_fits_pattern(pattern, target);
-  } while (does_word_match_excluded_patterns(target));
+    // The next target only depends on the green letters of the last guess, so
+    // a search for the same green letters can carry on.
+    if (memcmp(green_letters, next_target_green_letters, WORD_LENGTH) != 0)
+    {
+      memcpy(next_target_green_letters, green_letters, WORD_LENGTH);
+      next_target_search.start(next_target_green_letters);
+      scheduler.add(&next_target_search);
+    }
+  }
 
   return;
 }
 
 
-void RushGameplay::word_not_in_dictionary_notification()
+// The next target has usually been found on idle frames already, in which case
+// this only takes it and starts looking for the one after.
+void RushGameplay::swap_target_word()
 {
-  Notification notification("Word not in dictionary!");
-
-  notification.draw();
+  word_evaluation_t evaluation;
 
-  while (true)
-  {
-    Keypad::update_state();
-
-    if (Keypad::was_any_key_released())
-      break;
+  next_target_search.finish(target);
 
-    this->timer.update();
+  // Only the GREEN letters carry over to the new target, so they are all that
+  // Hard Mode can still require.
+  knowledge.reset();
 
-    if (this->timer.is_expired())
+  if (this->num_guesses > 0)
+  {
+    for (uint8_t index = 0; index < WORD_LENGTH; index++)
     {
-      swap_target_word();
-      this->timer.reload();
+      if (next_target_green_letters[index] != '\0')
+        evaluation[index] = POSITION_AND_LETTER_CORRECT;
+      else
+        evaluation[index] = UNEVALUATED;
     }
 
-    notification.blit();
-    this->timer.draw();
-    this->timer.blit();
+    knowledge.include_guess(
+      this->guesses[this->num_guesses - 1], evaluation
+    );
   }
 
+  next_target_search.start(next_target_green_letters);
+  scheduler.add(&next_target_search);
   return;
 }
 
@@ -681,6 +852,7 @@ void RushGameplay::word_not_in_dictionary_notification()
 void RushGameplay::scroll_to_guess_list_start()
 {
   this->scroll_index = 0;
+  stop_guess_list_scroll();
   return;
 }
 
@@ -699,6 +871,7 @@ void RushGameplay::scroll_to_guess_list_end()
     this->scroll_index = 0;
   }
 
+  stop_guess_list_scroll();
   return;
 }
 
@@ -728,40 +901,220 @@ void RushGameplay::scroll_guess_list_down()
 }
 
 
-void RushGameplay::results_screen(IN word_string_t current_guess)
+// The scroll keys only move scroll_index. The rows on screen follow it a few
+// pixels per frame, so no key press is lost while they catch up.
+bool RushGameplay::is_guess_list_scrolling() const
+{
+  return (
+    this->displayed_scroll_index != this->scroll_index
+    || this->num_scroll_pixels_left > 0
+  );
+}
+
+
+// Moves the rows in the window by one step with a memmove per scanline and
+// copies the matching scanlines of the incoming row into the part that the
+// move uncovers. No row is drawn again except the incoming one, once.
+void RushGameplay::step_guess_list_scroll()
+{
+  const uint8_t WINDOW_TOP = GUESS_LIST_YPOS;
+  const uint8_t WINDOW_BOTTOM = (
+    GUESS_LIST_YPOS + (NUM_VISIBLE_GUESSES * GUESS_ROW_HEIGHT)
+  );
+
+  gfx_sprite_t* incoming_row = (gfx_sprite_t*)incoming_guess_row;
+  bool is_scrolling_down = this->scroll_index > this->displayed_scroll_index;
+  uint8_t num_rows_left;
+  uint8_t num_pixels;
+  uint8_t strip_ypos;
+  rectangle_t window = {
+    .xpos = GUESS_WINDOW_XPOS,
+    .ypos = WINDOW_TOP,
+    .width = GUESS_WINDOW_WIDTH,
+    .height = (uint8_t)(WINDOW_BOTTOM - WINDOW_TOP)
+  };
+
+  if (this->num_scroll_pixels_left == 0)
+  {
+    this->is_scrolling_down = is_scrolling_down;
+    draw_incoming_guess_row(
+      is_scrolling_down
+      ? this->displayed_scroll_index + NUM_VISIBLE_GUESSES
+      : this->displayed_scroll_index - 1
+    );
+    this->num_scroll_pixels_left = GUESS_ROW_HEIGHT;
+  }
+
+  // A key press the other way while a row is part way in lets the row finish
+  // at the slowest speed before the list turns around.
+  is_scrolling_down = this->is_scrolling_down;
+  num_rows_left = 1;
+
+  if (is_scrolling_down && this->scroll_index > this->displayed_scroll_index)
+    num_rows_left = this->scroll_index - this->displayed_scroll_index;
+  else if (
+    !is_scrolling_down && this->scroll_index < this->displayed_scroll_index
+  )
+    num_rows_left = this->displayed_scroll_index - this->scroll_index;
+
+  num_pixels = SCROLL_STEP_PIXELS * num_rows_left;
+
+  if (num_pixels > this->num_scroll_pixels_left)
+    num_pixels = this->num_scroll_pixels_left;
+
+  this->num_scroll_pixels_left -= num_pixels;
+
+  if (is_scrolling_down)
+  {
+    for (uint8_t ypos = WINDOW_TOP; ypos < WINDOW_BOTTOM - num_pixels; ypos++)
+    {
+      memmove(
+        &gfx_vbuffer[ypos][GUESS_WINDOW_XPOS],
+        &gfx_vbuffer[ypos + num_pixels][GUESS_WINDOW_XPOS],
+        GUESS_WINDOW_WIDTH
+      );
+    }
+
+    strip_ypos = GUESS_ROW_HEIGHT - this->num_scroll_pixels_left - num_pixels;
+
+    for (uint8_t line = 0; line < num_pixels; line++)
+    {
+      memcpy(
+        &gfx_vbuffer[WINDOW_BOTTOM - num_pixels + line][GUESS_WINDOW_XPOS],
+        &incoming_row->data[(strip_ypos + line) * GUESS_WINDOW_WIDTH],
+        GUESS_WINDOW_WIDTH
+      );
+    }
+  }
+  else
+  {
+    for (
+      uint8_t ypos = WINDOW_BOTTOM - 1;
+      ypos >= WINDOW_TOP + num_pixels;
+      ypos--
+    )
+    {
+      memmove(
+        &gfx_vbuffer[ypos][GUESS_WINDOW_XPOS],
+        &gfx_vbuffer[ypos - num_pixels][GUESS_WINDOW_XPOS],
+        GUESS_WINDOW_WIDTH
+      );
+    }
+
+    strip_ypos = this->num_scroll_pixels_left;
+
+    for (uint8_t line = 0; line < num_pixels; line++)
+    {
+      memcpy(
+        &gfx_vbuffer[WINDOW_TOP + line][GUESS_WINDOW_XPOS],
+        &incoming_row->data[(strip_ypos + line) * GUESS_WINDOW_WIDTH],
+        GUESS_WINDOW_WIDTH
+      );
+    }
+  }
+
+  if (this->num_scroll_pixels_left == 0)
+  {
+    if (is_scrolling_down)
+      this->displayed_scroll_index++;
+    else
+      this->displayed_scroll_index--;
+  }
+
+  gui_MarkDirty(window);
+  draw_guess_list_scrollbar();
+  return;
+}
+
+
+void RushGameplay::stop_guess_list_scroll()
+{
+  this->displayed_scroll_index = this->scroll_index;
+  this->num_scroll_pixels_left = 0;
+  return;
+}
+
+
+// The back buffer is only shown where it is marked dirty, so the row can be
+// drawn in the window's last row and read back, as long as that row is put
+// back as it was before the frame is shown.
+void RushGameplay::draw_incoming_guess_row(IN uint8_t index) const
 {
-  bool redraw_foreground = false;
+  const uint8_t YPOS = (
+    GUESS_LIST_YPOS + ((NUM_VISIBLE_GUESSES - 1) * GUESS_ROW_HEIGHT)
+  );
 
-  draw_game_screen_background();
+  gfx_sprite_t* incoming_row = (gfx_sprite_t*)incoming_guess_row;
+  gfx_sprite_t* saved_row = (gfx_sprite_t*)saved_guess_row;
+  rectangle_t row = {
+    .xpos = GUESS_WINDOW_XPOS,
+    .ypos = YPOS,
+    .width = GUESS_WINDOW_WIDTH,
+    .height = GUESS_ROW_HEIGHT
+  };
+
+  incoming_row->width = GUESS_WINDOW_WIDTH;
+  incoming_row->height = GUESS_ROW_HEIGHT;
+  saved_row->width = GUESS_WINDOW_WIDTH;
+  saved_row->height = GUESS_ROW_HEIGHT;
+
+  gfx_GetSprite(saved_row, row.xpos, row.ypos);
+  gui_RestoreBackground(row);
+  draw_guess(index, YPOS);
+  gfx_GetSprite(incoming_row, row.xpos, row.ypos);
+  gfx_Sprite_NoClip(saved_row, row.xpos, row.ypos);
+  return;
+}
+
+
+void RushGameplay::results_screen(IN word_string_t current_guess)
+{
+  stop_guess_list_scroll();
+  gui_DrawGameScreenBackground();
   draw_game_screen_foreground(current_guess);
   gfx_BlitBuffer();
 
   while (true)
   {
-    Keypad::update_state();
+    FrameScheduler::start_frame();
 
     if (Keypad::is_down_repeating(kb_KeyUp))
-    {
       scroll_guess_list_up();
-      redraw_foreground = true;
-    }
     else if (Keypad::is_down_repeating(kb_KeyDown))
-    {
       scroll_guess_list_down();
-      redraw_foreground = true;
-    }
     else if (Keypad::was_released_exclusive(kb_KeyClear))
-    {
       break;
-    }
 
-    if (redraw_foreground)
+    if (is_guess_list_scrolling())
     {
-      draw_game_screen_foreground(current_guess);
-      gfx_SwapDraw();
-      redraw_foreground = false;
+      step_guess_list_scroll();
+      gui_BlitDirtyRegions();
     }
   }
 
   return;
 }
+
+
+// ============================================================================
+// STATIC FUNCTION DEFINITIONS
+// ============================================================================
+
+
+static void draw_num_bytes_blitted()
+{
+  GuiText text;
+  rectangle_t region = {
+    .xpos = 2,
+    .ypos = LCD_HEIGHT - GFX_DEFAULT_FONT_HEIGHT - 4,
+    .width = 60,
+    .height = GFX_DEFAULT_FONT_HEIGHT + 2
+  };
+
+  gui_RestoreBackground(region);
+  text.set_font(GuiText::NORMAL_SIZE_WITH_SHADOW);
+  text.set_xpos(region.xpos);
+  text.set_ypos(region.ypos);
+  text.draw_unsigned_int(gui_GetNumBytesBlitted());
+  return;
+}
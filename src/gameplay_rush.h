@@ -3,6 +3,9 @@
 
 
 #include "gameplay.h"
+#include "knowledge.h"
+#include "scheduler.h"
+#include "systemclock.h"
 
 
 class Timer
@@ -10,14 +13,13 @@ class Timer
   public:
     Timer();
 
-    void update();
+    bool update();
     void reload();
     void freeze_updates();
     void thaw_updates();
 
     bool is_expired() const;
     void draw() const;
-    void blit() const;
 
   private:
     const uint24_t WIDTH = 40;
@@ -26,11 +28,43 @@ class Timer
     const uint8_t YPOS = 10;
     const uint8_t RELOAD_VALUE = 60;
 
-    clock_t start_timestamp;
+    ticks_t next_second_deadline;
+    ticks_t freeze_timestamp;
     uint8_t num_seconds_left;
 };
 
 
+// Looks for the next target a slice at a time. The next target keeps the green
+// letters of the last guess, may not end in S unless that S is green, and may
+// not match any excluded pattern. If no word fits all of that, the search
+// starts over with just the green letters.
+class TargetSearch : public Task
+{
+  public:
+    TargetSearch(
+      IN Dictionary& dictionary,
+      IN CompiledWordPattern* excluded_patterns,
+      IN uint8_t num_excluded_patterns
+    );
+
+    void start(IN word_string_t green_letters);
+    bool step();
+    void finish(OUT Word& target);
+
+  private:
+    static const uint24_t NUM_WORDS_PER_STEP = 32;
+
+    const Dictionary& dictionary;
+    const CompiledWordPattern* excluded_patterns;
+    uint8_t num_excluded_patterns;
+    PatternSampler sampler;
+    word_string_t green_letters;
+    bool is_relaxed;
+
+    void start_sampler();
+};
+
+
 class RushGameplay : public Gameplay
 {
   public:
@@ -41,35 +75,45 @@ class RushGameplay : public Gameplay
     static const uint8_t ID = 1;
     static const uint8_t MAX_NUM_GUESSES = 20;
     const uint8_t NUM_VISIBLE_GUESSES = 7;
+    static const uint8_t NUM_EXCLUDED_PATTERNS = 2;
 
     Timer timer;
+    KnowledgeState knowledge;
     Dictionary dictionary;
+    CompiledWordPattern excluded_patterns[NUM_EXCLUDED_PATTERNS];
+    TargetSearch next_target_search;
+    word_string_t next_target_green_letters;
     Word target;
     Word guesses[MAX_NUM_GUESSES];
     word_evaluation_t guess_evaluations[MAX_NUM_GUESSES];
     uint8_t num_guesses;
     uint8_t scroll_index;
+    uint8_t displayed_scroll_index;
+    uint8_t num_scroll_pixels_left;
+    bool is_scrolling_down;
 
-    void draw_game_screen_background() const;
     void draw_game_screen_foreground(IN word_string_t current_guess) const;
     void draw_guesses() const;
+    void draw_guess(IN uint8_t index, IN uint8_t ypos) const;
+    void draw_incoming_guess_row(IN uint8_t index) const;
     void draw_guess_list_scrollbar() const;
     void draw_win_animation() const;
     void draw_lose_animation() const;
     bool is_last_guess_correct() const;
     bool are_all_guesses_used() const;
-    bool does_word_match_excluded_patterns(IN Word& word) const;
     pause_menu_code_t pause_menu() const;
     void show_help_screen() const;
 
     void reset_guesses();
     void add_guess(IN word_string_t guess);
     void swap_target_word();
-    void word_not_in_dictionary_notification();
     void scroll_to_guess_list_start();
     void scroll_to_guess_list_end();
     void scroll_guess_list_up();
     void scroll_guess_list_down();
+    bool is_guess_list_scrolling() const;
+    void step_guess_list_scroll();
+    void stop_guess_list_scroll();
     void results_screen(IN word_string_t current_guess);
 };
 
@@ -3,11 +3,14 @@
 #include <ti/screen.h>
 #include <assert.h>
 #include <graphx.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "gfx/gfx.h"
+#include "framescheduler.h"
 #include "gui.h"
 #include "keypad.h"
+#include "systemclock.h"
 
 
 // ============================================================================
@@ -26,17 +29,124 @@ typedef struct
 } button_attributes_t;
 
 
+// Regions of the back buffer that have been drawn to since the last blit.
+// Touching regions are merged, and once the list is full every region is
+// merged into one.
+#define MAX_NUM_DIRTY_REGIONS (8)
+
+static rectangle_t dirty_regions[MAX_NUM_DIRTY_REGIONS];
+static uint8_t num_dirty_regions = 0;
+static uint24_t num_bytes_blitted = 0;
+
+// Both backgrounds are checkered in BACKGROUND_CELL_SIZE squares and are the
+// same in every row of cells that starts on an even row or on an odd row, so
+// one scanline for each kind of row holds the whole background.
+#define BACKGROUND_CELL_SIZE (16)
+
+enum background_t : uint8_t
+{
+  NO_BACKGROUND = 0,
+  CHECKERED_BACKGROUND,
+  GAME_SCREEN_BACKGROUND
+};
+
+static background_t background = NO_BACKGROUND;
+static uint8_t background_scanlines[2][LCD_WIDTH];
+
+// Glyphs of the white NORMAL_SIZE_WITH_SHADOW font with the shadow already
+// drawn in, so that a string is one transparent sprite per character. Each
+// glyph is built the first time it is drawn; until then its width is zero.
+#define FIRST_ATLAS_CHARACTER (' ')
+#define LAST_ATLAS_CHARACTER  ('~')
+#define NUM_ATLAS_GLYPHS      (LAST_ATLAS_CHARACTER - FIRST_ATLAS_CHARACTER + 1)
+#define ATLAS_GLYPH_SIZE      (GFX_DEFAULT_FONT_HEIGHT + 1)
+
+static uint8_t font_atlas[NUM_ATLAS_GLYPHS][
+  2 + (ATLAS_GLYPH_SIZE * ATLAS_GLYPH_SIZE)
+];
+
+// One filled shape of a widget. A rounded layer covers one pixel more than
+// its width and height, as the circles of its corners do; a square layer
+// covers exactly its width and height.
+typedef struct
+{
+  rectangle_t rectangle;
+  uint8_t color;
+  uint8_t corner_radius;
+} layer_t;
+
+#define MAX_NUM_LAYERS (4)
+
+// The columns from left to right, inclusive, of one scanline.
+typedef struct
+{
+  uint24_t left;
+  uint24_t right;
+} span_t;
+
+// For every corner radius, how far each of the top `radius` rows of a rounded
+// layer is inset from its sides. A radius's insets are worked out the first
+// time it is drawn.
+#define MAX_CORNER_RADIUS (16)
+
+static uint8_t corner_insets[MAX_CORNER_RADIUS + 1][MAX_CORNER_RADIUS];
+static bool has_corner_insets[MAX_CORNER_RADIUS + 1] = { false };
+
+// Transitions reveal the back buffer from the bottom up over this long, as
+// measured by the system clock. A duration of zero turns them off.
+static ticks_t transition_duration = DEFAULT_TRANSITION_DURATION;
+
+// Notifications are shown one at a time, in the order they were queued, for
+// NOTIFICATION_TIMEOUT each. The first one is drawn into the back buffer just
+// before a blit and the back buffer under it is put back just after, so that
+// screens can go on drawing as if it were not there. Its box is revealed from
+// the left at NOTIFICATION_REVEAL_RATE columns per millisecond. The saved
+// underlay is allocated at the width of the notification that is showing, one
+// line after another, and freed when that notification goes away.
+#define MAX_NUM_QUEUED_NOTIFICATIONS (4)
+#define NOTIFICATION_YPOS            (10)
+#define NOTIFICATION_HEIGHT          (31)
+#define NOTIFICATION_REVEAL_RATE     (2)
+#define NOTIFICATION_TIMEOUT         (2 * TICKS_PER_SECOND)
+
+static Notification notifications[MAX_NUM_QUEUED_NOTIFICATIONS];
+static uint8_t first_notification_index = 0;
+static uint8_t num_notifications = 0;
+static ticks_t notification_timestamp;
+static uint24_t num_notification_columns_shown = 0;
+static uint8_t* notification_underlay = NULL;
+
+
 // ============================================================================
 // STATIC FUNCTION DECLARATIONS
 // ============================================================================
 
 
 static unsigned int log10(IN unsigned int value);
-static void draw_filled_rectangle(IN rectangle_t& rectangle);
-static void draw_filled_rounded_rectangle(
-  IN rectangle_t& rectangle, IN uint8_t corner_radius
+static bool is_atlas_character(IN char character);
+static gfx_sprite_t* get_atlas_glyph(IN char character);
+static bool do_regions_touch(
+  IN rectangle_t& first_region, IN rectangle_t& second_region
+);
+static void merge_region_into_region(
+  IN rectangle_t& source, MOD rectangle_t& destination
+);
+static const uint8_t* get_corner_insets(IN uint8_t corner_radius);
+static void fill_span(
+  IN uint8_t ypos, IN uint24_t left, IN uint24_t right, IN uint8_t color
+);
+static void draw_layers(IN layer_t* layers, IN uint8_t num_layers);
+static void add_covered_span(
+  IN span_t& span, MOD span_t* covered_spans, MOD uint8_t& num_covered_spans
 );
 static void draw_button(IN button_attributes_t& attributes);
+static void draw_background(IN background_t new_background);
+static void reveal_back_buffer();
+static bool update_notifications();
+static void draw_notification_overlay(IN rectangle_t& overlay);
+static void remove_notification_overlay(IN rectangle_t& overlay);
+static void get_notification_overlay(OUT rectangle_t& overlay);
+static void free_notification_underlay();
 static void draw_gameplay_option(
   IN char* title, IN point_t& origin, MOD Container& container
 );
@@ -63,16 +173,73 @@ uint8_t GuiText::get_font_height() const
 }
 
 
+uint24_t GuiText::get_string_width(IN char* string) const
+{
+  uint24_t width = 0;
+
+  if (!uses_font_atlas())
+    return gfx_GetStringWidth(string);
+
+  for (const char* character = string; *character != '\0'; character++)
+  {
+    if (is_atlas_character(*character))
+      width += get_atlas_glyph(*character)->width - 1;
+    else
+      width += gfx_GetCharWidth(*character);
+  }
+
+  return width;
+}
+
+
 void GuiText::draw_string(IN char* string)
 {
   const char* character = string;
+  const uint24_t START_XPOS = gfx_GetTextX();
+  const uint8_t YPOS = gfx_GetTextY();
+
+  uint24_t xpos = START_XPOS;
+  gfx_sprite_t* glyph;
+
+  if (!uses_font_atlas())
+  {
+    while (*character != '\0')
+    {
+      draw_character(*character);
+      character++;
+    }
+
+    return;
+  }
 
   while (*character != '\0')
   {
-    draw_character(*character);
+    if (is_atlas_character(*character))
+    {
+      glyph = get_atlas_glyph(*character);
+      gfx_TransparentSprite_NoClip(glyph, xpos, YPOS);
+      xpos += glyph->width - 1;
+    }
+    else
+    {
+      gfx_SetTextXY(xpos, YPOS);
+      draw_character(*character);
+      xpos = gfx_GetTextX();
+    }
+
     character++;
   }
 
+  gfx_SetTextXY(xpos, YPOS);
+
+  rectangle_t region = {
+    .xpos = START_XPOS,
+    .ypos = YPOS,
+    .width = xpos - START_XPOS + 1,
+    .height = ATLAS_GLYPH_SIZE
+  };
+
+  gui_MarkDirty(region);
   return;
 }
 
@@ -82,7 +249,7 @@ void GuiText::draw_centered_string(IN char* string)
   // The font scale must be set before the string's width is calculated.
   // gfx_SetTextScale(this->horizontal_scale, this->vertical_scale);
 
-  set_xpos((LCD_WIDTH - gfx_GetStringWidth(string)) / 2);
+  set_xpos((LCD_WIDTH - get_string_width(string)) / 2);
   draw_string(string);
   return;
 }
@@ -109,6 +276,15 @@ void GuiText::draw_character(IN char character)
   gfx_SetTextXY(XPOS, YPOS);
   gfx_SetTextFGColor(this->foreground_color);
   gfx_PrintChar(character);
+
+  rectangle_t region = {
+    .xpos = XPOS,
+    .ypos = YPOS,
+    .width = gfx_GetCharWidth(character) + z_index,
+    .height = (uint8_t)(get_font_height() + z_index)
+  };
+
+  gui_MarkDirty(region);
   return;
 }
 
@@ -134,10 +310,30 @@ void GuiText::draw_unsigned_int(IN unsigned int integer)
   gfx_SetTextXY(XPOS, YPOS);
   gfx_SetTextFGColor(this->foreground_color);
   gfx_PrintUInt(integer, log10(integer));
+
+  rectangle_t region = {
+    .xpos = XPOS,
+    .ypos = YPOS,
+    .width = (log10(integer) * gfx_GetCharWidth('0')) + z_index,
+    .height = (uint8_t)(get_font_height() + z_index)
+  };
+
+  gui_MarkDirty(region);
   return;
 }
 
 
+bool GuiText::uses_font_atlas() const
+{
+  return (
+    this->z_index == 1
+    && this->horizontal_scale == 1
+    && this->vertical_scale == 1
+    && this->foreground_color == WHITE
+  );
+}
+
+
 void GuiText::set_font(IN font_style_t font_style)
 {
   switch (font_style)
@@ -207,6 +403,14 @@ void GuiText::set_font(IN font_style_t font_style)
 }
 
 
+// Must be called after set_font(), which resets the color.
+void GuiText::set_color(IN uint8_t color)
+{
+  this->foreground_color = color;
+  return;
+}
+
+
 void GuiText::set_xpos(IN uint24_t xpos)
 {
   gfx_SetTextXY(xpos, gfx_GetTextY());
@@ -243,6 +447,7 @@ void Rectangle::draw() const
   gfx_FillRectangle_NoClip(
     rectangle.xpos, rectangle.ypos, rectangle.width, rectangle.height
   );
+  gui_MarkDirty(rectangle);
   return;
 }
 
@@ -362,11 +567,16 @@ DecoratedRectangle::DecoratedRectangle()
 }
 
 
-void DecoratedRectangle::draw()
+// Drawing leaves the rectangle as it was, so a retained widget can draw the
+// same one again every time it is invalidated.
+void DecoratedRectangle::draw() const
 {
   rectangle_t shadow_rectangle = rectangle;
   rectangle_t highlight_rectangle = rectangle;
   rectangle_t border_rectangle = rectangle;
+  rectangle_t inner_rectangle = rectangle;
+  layer_t layers[4];
+  uint8_t num_layers = 0;
 
   if (inset)
   {
@@ -381,55 +591,43 @@ void DecoratedRectangle::draw()
     shadow_rectangle.ypos += z_index;
   }
 
-  if (border_radius > 0)
+  if (inset)
   {
-    if (inset)
-    {
-      gfx_SetColor(WHITE);
-      draw_filled_rounded_rectangle(highlight_rectangle, border_radius);
-    }
-
-    if (z_index > 0)
-    {
-      gfx_SetColor(BLACK);
-      draw_filled_rounded_rectangle(shadow_rectangle, border_radius);
-    }
-
-    if (border_thickness > 0)
-    {
-      gfx_SetColor(border_color);
-      draw_filled_rounded_rectangle(border_rectangle, border_radius);
-      shrink_towards_center_by_num_pixels(2 * border_thickness);
-    }
-
-    gfx_SetColor(color);
-    draw_filled_rounded_rectangle(rectangle, border_radius);
+    layers[num_layers].rectangle = highlight_rectangle;
+    layers[num_layers].color = WHITE;
+    num_layers++;
   }
-  else
+
+  if (z_index > 0)
   {
-    if (inset)
-    {
-      gfx_SetColor(WHITE);
-      draw_filled_rectangle(highlight_rectangle);
-    }
+    layers[num_layers].rectangle = shadow_rectangle;
+    layers[num_layers].color = BLACK;
+    num_layers++;
+  }
 
-    if (z_index > 0)
-    {
-      gfx_SetColor(BLACK);
-      draw_filled_rectangle(shadow_rectangle);
-    }
+  if (border_thickness > 0)
+  {
+    layers[num_layers].rectangle = border_rectangle;
+    layers[num_layers].color = border_color;
+    num_layers++;
 
-    if (border_thickness > 0)
-    {
-      gfx_SetColor(border_color);
-      draw_filled_rectangle(border_rectangle);
-      shrink_towards_center_by_num_pixels(2 * border_thickness);
-    }
+    assert(inner_rectangle.width >= 2 * border_thickness);
+    assert(inner_rectangle.height >= 2 * border_thickness);
 
-    gfx_SetColor(color);
-    draw_filled_rectangle(rectangle);
+    inner_rectangle.xpos += border_thickness;
+    inner_rectangle.ypos += border_thickness;
+    inner_rectangle.width -= 2 * border_thickness;
+    inner_rectangle.height -= 2 * border_thickness;
   }
 
+  layers[num_layers].rectangle = inner_rectangle;
+  layers[num_layers].color = color;
+  num_layers++;
+
+  for (uint8_t index = 0; index < num_layers; index++)
+    layers[index].corner_radius = border_radius;
+
+  draw_layers(layers, num_layers);
   return;
 }
 
@@ -540,6 +738,16 @@ void InputField::draw_input(IN char* input)
 // ============================================================================
 
 
+Notification::Notification()
+{
+  this->container.xpos = 0;
+  this->container.ypos = 0;
+  this->container.width = 0;
+  this->container.height = 0;
+  return;
+}
+
+
 Notification::Notification(IN char* message)
 {
   assert(strlen(message) <= MAX_MESSAGE_LENGTH);
@@ -553,11 +761,18 @@ Notification::Notification(IN char* message)
   this->container.ypos = 17;
   this->container.width = gfx_GetStringWidth(message) + 32;
   this->container.height = 19;
-  this->animation_index = 0;
   return;
 }
 
 
+// The width of the notification from the left edge of the screen, which
+// includes the icon and one more column for the rounded corners.
+uint24_t Notification::get_width() const
+{
+  return this->container.xpos + this->container.width + 1;
+}
+
+
 void Notification::draw()
 {
   rectangle_t inner_border = this->container;
@@ -570,298 +785,607 @@ void Notification::draw()
   content.width -= 2;
   content.height -= 2;
 
-  gfx_SetColor(BLACK);
-  draw_filled_rounded_rectangle(this->container, 6);
-  gfx_SetColor(WHITE);
-  draw_filled_rounded_rectangle(inner_border, 6);
-  gfx_SetColor(ORANGE);
-  draw_filled_rounded_rectangle(content, 6);
+  layer_t layers[3] = {
+    { .rectangle = this->container, .color = BLACK, .corner_radius = 6 },
+    { .rectangle = inner_border, .color = WHITE, .corner_radius = 6 },
+    { .rectangle = content, .color = ORANGE, .corner_radius = 6 }
+  };
+
+  draw_layers(layers, 3);
 
   this->text.set_xpos(this->container.xpos + 21);
   this->text.set_ypos(this->container.ypos + 4);
   this->text.draw_string(message);
 
-  gfx_TransparentSprite_NoClip(spr_notification_icon, 0, 10);
+  gfx_TransparentSprite_NoClip(spr_notification_icon, 0, NOTIFICATION_YPOS);
   return;
 }
 
 
-void Notification::blit()
+// ============================================================================
+// CLASS Widget FUNCTION DEFINITIONS
+// ============================================================================
+
+
+Widget::Widget()
 {
-  const uint24_t DELAY = CLOCKS_PER_SEC / 1000;
+  this->first_child = NULL;
+  this->next_sibling = NULL;
+  this->needs_redraw = true;
+  return;
+}
 
-  static clock_t timestamp = clock();
 
-  gfx_BlitRectangle(
-    gfx_buffer,
-    0,
-    10,
-    spr_notification_icon->width,
-    spr_notification_icon->height
-  );
+// Children are drawn in the order they are added, so later children are drawn
+// on top of earlier ones.
+void Widget::add_child(MOD Widget& child)
+{
+  Widget* last_child = this->first_child;
 
-  if (
-    this->animation_index < this->container.width
-    && clock() > (timestamp + DELAY)
-  )
-  {
-    gfx_BlitRectangle(
-      gfx_buffer,
-      spr_notification_icon->width + this->animation_index,
-      15,
-      2,
-      22
-    );
+  child.next_sibling = NULL;
+  child.invalidate();
 
-    this->animation_index += 2;
-    timestamp = clock() + DELAY;
+  if (last_child == NULL)
+  {
+    this->first_child = &child;
+    return;
   }
 
+  while (last_child->next_sibling != NULL)
+    last_child = last_child->next_sibling;
+
+  last_child->next_sibling = &child;
   return;
 }
 
 
-// ============================================================================
-// PUBLIC FUNCTION DEFINITIONS
-// ============================================================================
+void Widget::invalidate()
+{
+  this->needs_redraw = true;
+  return;
+}
 
 
-void gui_StartGraphics()
+void Widget::render()
 {
-  gfx_Begin();
-  gfx_SetPalette(global_palette, sizeof_global_palette, 0);
-  gfx_SetDrawBuffer();
+  render_tree(false);
   return;
 }
 
 
-void gui_EndGraphics()
+void Widget::draw_self()
 {
-  gfx_End();
   return;
 }
 
 
-void gui_DrawHelpScreen(IN char** strings, IN uint8_t num_strings)
+void Widget::render_tree(IN bool must_draw)
 {
-  const uint8_t LINE_HEIGHT = GFX_DEFAULT_FONT_HEIGHT + 3;
+  const bool DRAW = must_draw || this->needs_redraw;
 
-  GuiText text;
-  uint8_t text_ypos = 60;
+  if (DRAW)
+    draw_self();
 
-  gui_DrawCheckeredBackground();
-  gui_DrawMenuTitle("Help");
-  text.set_font(GuiText::NORMAL_SIZE_WITH_SHADOW);
+  this->needs_redraw = false;
 
-  for (uint8_t index = 0; index < num_strings; index++)
-  {
-    text.set_xpos(5);
-    text.set_ypos(text_ypos);
-    text.draw_string(strings[index]);
-    text_ypos += LINE_HEIGHT;
-  }
+  for (
+    Widget* child = this->first_child;
+    child != NULL;
+    child = child->next_sibling
+  )
+    child->render_tree(DRAW);
 
   return;
 }
 
 
-void gui_DrawButton(IN char* title, IN uint8_t ypos)
-{
-  button_attributes_t attributes = {
-    .title = title,
-    .ypos = ypos,
-    .highlight_color = LIGHT_BLUE,
-    .main_color = LIGHT_MED_BLUE,
-    .inner_shadow_color = BLUE,
-    .text_color = WHITE
-  };
+// ============================================================================
+// CLASS ScreenWidget FUNCTION DEFINITIONS
+// ============================================================================
 
-  draw_button(attributes);
+
+ScreenWidget::ScreenWidget(IN char* title)
+{
+  this->title = title;
   return;
 }
 
 
-void gui_DrawButtonSelected(IN char* title, IN uint8_t ypos)
+void ScreenWidget::draw_self()
 {
-  button_attributes_t attributes = {
-    .title = title,
-    .ypos = ypos,
-    .highlight_color = LIGHT_ORANGE,
-    .main_color = ORANGE,
-    .inner_shadow_color = DARK_ORANGE,
-    .text_color = WHITE
-  };
+  gui_DrawCheckeredBackground();
+
+  if (this->title != NULL)
+    gui_DrawMenuTitle(this->title);
 
-  draw_button(attributes);
   return;
 }
 
 
-void gui_DrawMenuTitle(IN char* title)
-{
-  const uint8_t TITLE_YPOS = 15;
-  const uint24_t LINE_WIDTH = 256;
-  const uint24_t LINE_XPOS = (LCD_WIDTH - LINE_WIDTH) / 2;
-
-  GuiText text;
-  uint8_t line_ypos;
+// ============================================================================
+// CLASS SpriteWidget FUNCTION DEFINITIONS
+// ============================================================================
 
-  text.set_font(GuiText::MENU_TITLE);
-  text.set_ypos(TITLE_YPOS);
-  text.draw_centered_string(title);
 
-  line_ypos = TITLE_YPOS + text.get_font_height() + 4;
+SpriteWidget::SpriteWidget(
+  IN gfx_sprite_t* sprite,
+  IN uint24_t xpos,
+  IN uint8_t ypos,
+  IN uint8_t horizontal_scale,
+  IN uint8_t vertical_scale
+)
+{
+  this->sprite = sprite;
+  this->region.xpos = xpos;
+  this->region.ypos = ypos;
+  this->region.width = sprite->width * horizontal_scale;
+  this->region.height = sprite->height * vertical_scale;
+  this->horizontal_scale = horizontal_scale;
+  this->vertical_scale = vertical_scale;
+  return;
+}
 
-  gfx_SetColor(BLACK);
-  gfx_FillRectangle_NoClip(LINE_XPOS + 2, line_ypos + 2, LINE_WIDTH, 2);
 
-  gfx_SetColor(WHITE);
-  gfx_FillRectangle_NoClip(LINE_XPOS, line_ypos, LINE_WIDTH, 2);
+void SpriteWidget::draw_self()
+{
+  gfx_ScaledTransparentSprite_NoClip(
+    this->sprite,
+    this->region.xpos,
+    this->region.ypos,
+    this->horizontal_scale,
+    this->vertical_scale
+  );
+  gui_MarkDirty(this->region);
   return;
 }
 
 
-void gui_Notification(IN char* message)
-{
-  GuiText text;
-  text.set_font(GuiText::NORMAL_SIZE_WITH_SHADOW);
+// ============================================================================
+// CLASS ButtonWidget FUNCTION DEFINITIONS
+// ============================================================================
 
-  const uint24_t CONTAINER_WIDTH = gfx_GetStringWidth(message) + 30;
 
-  rectangle_t container = {
-    .xpos = 7,
-    .ypos = 17,
-    .width = CONTAINER_WIDTH + 2,
-    .height = 19
-  };
+ButtonWidget::ButtonWidget()
+{
+  this->title = "";
+  this->ypos = 0;
+  this->selected = false;
+  return;
+}
 
-  gfx_SetColor(BLACK);
-  draw_filled_rounded_rectangle(container, 6);
-  container.xpos -= 2;
-  container.ypos -= 2;
-  gfx_SetColor(WHITE);
-  draw_filled_rounded_rectangle(container, 6);
-  container.xpos += 1;
-  container.ypos += 1;
-  container.width -= 2;
-  container.height -= 2;
-  gfx_SetColor(ORANGE);
-  draw_filled_rounded_rectangle(container, 6);
 
+void ButtonWidget::set_title(IN char* title)
+{
+  this->title = title;
+  invalidate();
+  return;
+}
 
-  text.set_xpos(28);
-  text.set_ypos(21);
-  text.draw_string(message);
 
-  gfx_TransparentSprite_NoClip(spr_notification_icon, 0, 10);
+void ButtonWidget::set_ypos(IN uint8_t ypos)
+{
+  this->ypos = ypos;
+  invalidate();
+  return;
+}
 
-  for (uint24_t index = 0; index < CONTAINER_WIDTH; index++)
-  {
-     gfx_BlitRectangle(
-      gfx_buffer,
-      0,
-      10,
-      spr_notification_icon->width + index,
-      spr_notification_icon->height
-    );
 
-    delay(1);
+void ButtonWidget::set_selected(IN bool selected)
+{
+  if (selected != this->selected)
+  {
+    this->selected = selected;
+    invalidate();
   }
 
-  Keypad::block_until_any_key_released();
   return;
 }
 
 
-void gui_DrawPageNumberIndicator(
-  IN uint8_t num_pages, IN uint8_t current_page_num
-)
+// A selected and an unselected button cover the same pixels, so each one
+// erases the other.
+void ButtonWidget::draw_self()
 {
-  const uint24_t HORIZONTAL_SPACING = 5;
-
-  point_t dot = {
-    .xpos = (
-      LCD_WIDTH - (num_pages * (spr_page_dot->width + HORIZONTAL_SPACING))
-    ) / 2,
-    .ypos = 219
-  };
+  if (this->selected)
+    gui_DrawButtonSelected(this->title, this->ypos);
+  else
+    gui_DrawButton(this->title, this->ypos);
 
-  gfx_TransparentSprite_NoClip(
-    spr_page_arrow_left,
-    dot.xpos - spr_page_arrow_left->width - HORIZONTAL_SPACING,
-    dot.ypos
-  );
+  return;
+}
 
-  for (uint8_t page_num = 1; page_num <= num_pages; page_num++)
-  {
-    if (page_num == current_page_num)
-      gfx_TransparentSprite_NoClip(spr_page_dot, dot.xpos, dot.ypos);
-    else
-      gfx_TransparentSprite_NoClip(spr_page_dot_slot, dot.xpos, dot.ypos);
 
-    dot.xpos += spr_page_dot->width + HORIZONTAL_SPACING;
-  }
+// ============================================================================
+// CLASS TextWidget FUNCTION DEFINITIONS
+// ============================================================================
 
-  gfx_TransparentSprite_NoClip(spr_page_arrow_right, dot.xpos,dot.ypos);
 
+TextWidget::TextWidget()
+{
+  this->string = "";
+  this->font_style = GuiText::DEFAULT;
+  this->ypos = 0;
   return;
 }
 
 
-void gui_DrawGameplayOption(IN char* title, IN point_t& origin)
+void TextWidget::set_string(IN char* string)
 {
-  Container container;
-
-  container.set_z_index(6);
-  draw_gameplay_option(title, origin, container);
+  this->string = string;
+  invalidate();
   return;
 }
 
 
-void gui_DrawGameplayOptionSelected(IN char* title, IN point_t& origin)
+void TextWidget::set_font(IN GuiText::font_style_t font_style)
 {
-  Container container;
-
-  container.set_color(ORANGE);
-  container.set_z_index(10);
-  draw_gameplay_option(title, origin, container);
+  this->font_style = font_style;
+  invalidate();
   return;
 }
 
 
-void gui_DrawCheckeredBackground()
+void TextWidget::set_ypos(IN uint8_t ypos)
 {
-  gfx_FillScreen(DARK_BLUE);
-  gfx_SetColor(DARK_MED_BLUE);
-
-  for (uint8_t ypos = 0; ypos < LCD_HEIGHT; ypos += 16)
-  {
-    for (uint24_t xpos = 0; xpos < LCD_WIDTH; xpos += 16)
-    {
-      if (xpos % 32 == ypos % 32)
-        gfx_FillRectangle_NoClip(xpos, ypos, 16, 16);
-    }
-  }
-
+  this->ypos = ypos;
+  invalidate();
   return;
 }
 
 
-void gui_TransitionIn()
+void TextWidget::draw_self()
 {
-  for (uint8_t ypos = LCD_HEIGHT - 1; ypos > 0; ypos--)
+  GuiText text;
+
+  text.set_font(this->font_style);
+  text.set_ypos(this->ypos);
+  text.draw_centered_string(this->string);
+  return;
+}
+
+
+// ============================================================================
+// CLASS ContainerWidget FUNCTION DEFINITIONS
+// ============================================================================
+
+
+void ContainerWidget::draw_self()
+{
+  draw();
+  return;
+}
+
+
+// ============================================================================
+// CLASS InputFieldWidget FUNCTION DEFINITIONS
+// ============================================================================
+
+
+InputFieldWidget::InputFieldWidget(
+  IN uint8_t ypos, IN uint24_t width
+): InputField(ypos, width)
+{
+  this->input = "";
+  return;
+}
+
+
+// The input is kept by reference, so this must also be called after the
+// string has been changed in place.
+void InputFieldWidget::set_input(IN char* input)
+{
+  this->input = input;
+  invalidate();
+  return;
+}
+
+
+// The field fills its whole area before drawing the input, which erases the
+// input drawn before.
+void InputFieldWidget::draw_self()
+{
+  draw_input(this->input);
+  return;
+}
+
+
+// ============================================================================
+// PUBLIC FUNCTION DEFINITIONS
+// ============================================================================
+
+
+void gui_StartGraphics()
+{
+  gfx_Begin();
+  gfx_SetPalette(global_palette, sizeof_global_palette, 0);
+  gfx_SetDrawBuffer();
+  return;
+}
+
+
+void gui_EndGraphics()
+{
+  gfx_End();
+  return;
+}
+
+
+void gui_DrawHelpScreen(IN char** strings, IN uint8_t num_strings)
+{
+  const uint8_t LINE_HEIGHT = GFX_DEFAULT_FONT_HEIGHT + 3;
+
+  GuiText text;
+  uint8_t text_ypos = 60;
+
+  gui_DrawCheckeredBackground();
+  gui_DrawMenuTitle("Help");
+  text.set_font(GuiText::NORMAL_SIZE_WITH_SHADOW);
+
+  for (uint8_t index = 0; index < num_strings; index++)
   {
-    gfx_BlitLines(gfx_buffer, ypos, 1);
-    delay(1);
+    text.set_xpos(5);
+    text.set_ypos(text_ypos);
+    text.draw_string(strings[index]);
+    text_ypos += LINE_HEIGHT;
   }
 
-  gfx_BlitLines(gfx_buffer, 0, 1);
+  return;
+}
+
+
+void gui_DrawButton(IN char* title, IN uint8_t ypos)
+{
+  button_attributes_t attributes = {
+    .title = title,
+    .ypos = ypos,
+    .highlight_color = LIGHT_BLUE,
+    .main_color = LIGHT_MED_BLUE,
+    .inner_shadow_color = BLUE,
+    .text_color = WHITE
+  };
+
+  draw_button(attributes);
+  return;
+}
+
+
+void gui_DrawButtonSelected(IN char* title, IN uint8_t ypos)
+{
+  button_attributes_t attributes = {
+    .title = title,
+    .ypos = ypos,
+    .highlight_color = LIGHT_ORANGE,
+    .main_color = ORANGE,
+    .inner_shadow_color = DARK_ORANGE,
+    .text_color = WHITE
+  };
+
+  draw_button(attributes);
+  return;
+}
+
+
+void gui_DrawMenuTitle(IN char* title)
+{
+  const uint8_t TITLE_YPOS = 15;
+  const uint24_t LINE_WIDTH = 256;
+  const uint24_t LINE_XPOS = (LCD_WIDTH - LINE_WIDTH) / 2;
+
+  GuiText text;
+  uint8_t line_ypos;
+
+  text.set_font(GuiText::MENU_TITLE);
+  text.set_ypos(TITLE_YPOS);
+  text.draw_centered_string(title);
+
+  line_ypos = TITLE_YPOS + text.get_font_height() + 4;
+
+  gfx_SetColor(BLACK);
+  gfx_FillRectangle_NoClip(LINE_XPOS + 2, line_ypos + 2, LINE_WIDTH, 2);
+
+  gfx_SetColor(WHITE);
+  gfx_FillRectangle_NoClip(LINE_XPOS, line_ypos, LINE_WIDTH, 2);
+
+  // The line and its shadow.
+  rectangle_t region = {
+    .xpos = LINE_XPOS,
+    .ypos = line_ypos,
+    .width = LINE_WIDTH + 2,
+    .height = 4
+  };
+
+  gui_MarkDirty(region);
+  return;
+}
+
+
+// Shows the notification over the current screen until it times out or a key
+// is released, for screens that have nothing else to do while it shows.
+void gui_Notification(IN char* message)
+{
+  gui_ClearNotifications();
+  gui_QueueNotification(message);
+
+  do
+  {
+    FrameScheduler::start_frame();
+    gui_BlitDirtyRegions();
+  } while (gui_IsNotificationShowing() && !Keypad::was_any_key_released());
+
+  gui_ClearNotifications();
+  gui_BlitDirtyRegions();
+  return;
+}
+
+
+// A notification that would not fit in the queue is dropped.
+void gui_QueueNotification(IN char* message)
+{
+  if (num_notifications == MAX_NUM_QUEUED_NOTIFICATIONS)
+    return;
+
+  notifications[
+    (first_notification_index + num_notifications)
+    % MAX_NUM_QUEUED_NOTIFICATIONS
+  ] = Notification(message);
+
+  if (num_notifications == 0)
+  {
+    notification_timestamp = SystemClock::now();
+    num_notification_columns_shown = 0;
+  }
+
+  num_notifications++;
+  return;
+}
+
+
+bool gui_IsNotificationShowing()
+{
+  return (num_notifications > 0);
+}
+
+
+void gui_ClearNotifications()
+{
+  rectangle_t overlay;
+
+  if (num_notifications > 0)
+  {
+    get_notification_overlay(overlay);
+    gui_MarkDirty(overlay);
+  }
+
+  free_notification_underlay();
+  first_notification_index = 0;
+  num_notifications = 0;
+  return;
+}
+
+
+void gui_DrawPageNumberIndicator(
+  IN uint8_t num_pages, IN uint8_t current_page_num
+)
+{
+  const uint24_t HORIZONTAL_SPACING = 5;
+
+  point_t dot = {
+    .xpos = (
+      LCD_WIDTH - (num_pages * (spr_page_dot->width + HORIZONTAL_SPACING))
+    ) / 2,
+    .ypos = 219
+  };
+  rectangle_t region = {
+    .xpos = dot.xpos - spr_page_arrow_left->width - HORIZONTAL_SPACING,
+    .ypos = dot.ypos,
+    .width = 0,
+    .height = spr_page_arrow_left->height
+  };
+
+  if (spr_page_dot->height > region.height)
+    region.height = spr_page_dot->height;
+
+  gfx_TransparentSprite_NoClip(spr_page_arrow_left, region.xpos, dot.ypos);
+
+  for (uint8_t page_num = 1; page_num <= num_pages; page_num++)
+  {
+    if (page_num == current_page_num)
+      gfx_TransparentSprite_NoClip(spr_page_dot, dot.xpos, dot.ypos);
+    else
+      gfx_TransparentSprite_NoClip(spr_page_dot_slot, dot.xpos, dot.ypos);
+
+    dot.xpos += spr_page_dot->width + HORIZONTAL_SPACING;
+  }
+
+  gfx_TransparentSprite_NoClip(spr_page_arrow_right, dot.xpos, dot.ypos);
+
+  region.width = dot.xpos + spr_page_arrow_right->width - region.xpos;
+  gui_MarkDirty(region);
+  return;
+}
+
+
+void gui_DrawGameplayOption(IN char* title, IN point_t& origin)
+{
+  Container container;
+
+  container.set_z_index(6);
+  draw_gameplay_option(title, origin, container);
+  return;
+}
+
+
+void gui_DrawGameplayOptionSelected(IN char* title, IN point_t& origin)
+{
+  Container container;
+
+  container.set_color(ORANGE);
+  container.set_z_index(10);
+  draw_gameplay_option(title, origin, container);
+  return;
+}
+
+
+void gui_DrawCheckeredBackground()
+{
+  draw_background(CHECKERED_BACKGROUND);
+  return;
+}
+
+
+// The checkered background with a plain panel down the middle for the game
+// board, framed by a white and a black line on each side.
+void gui_DrawGameScreenBackground()
+{
+  draw_background(GAME_SCREEN_BACKGROUND);
+  return;
+}
+
+
+// Copies the part of the last background drawn that lies under the region
+// back into the buffer, erasing whatever was drawn over it.
+void gui_RestoreBackground(IN rectangle_t& region)
+{
+  uint24_t width = region.width;
+  uint8_t height = region.height;
+
+  if (
+    background == NO_BACKGROUND
+    || region.xpos >= LCD_WIDTH || region.ypos >= LCD_HEIGHT
+  )
+    return;
+
+  if (region.xpos + width > LCD_WIDTH)
+    width = LCD_WIDTH - region.xpos;
+
+  if (region.ypos + height > LCD_HEIGHT)
+    height = LCD_HEIGHT - region.ypos;
+
+  for (uint8_t ypos = region.ypos; ypos < region.ypos + height; ypos++)
+  {
+    memcpy(
+      &gfx_vbuffer[ypos][region.xpos],
+      &background_scanlines[(ypos / BACKGROUND_CELL_SIZE) % 2][region.xpos],
+      width
+    );
+  }
+
+  gui_MarkDirty(region);
+  return;
+}
+
+
+void gui_TransitionIn()
+{
+  reveal_back_buffer();
+  num_dirty_regions = 0;
   return;
 }
 
 
 void gui_TransitionOut()
 {
+  gui_ClearNotifications();
   gfx_FillScreen(DARK_BLUE);
   gfx_SetColor(DARK_MED_BLUE);
 
@@ -874,18 +1398,111 @@ void gui_TransitionOut()
     }
   }
 
-  for (uint8_t ypos = LCD_HEIGHT - 1; ypos > 0; ypos--)
+  reveal_back_buffer();
+  num_dirty_regions = 0;
+  return;
+}
+
+
+void gui_SetTransitionDuration(IN ticks_t duration)
+{
+  transition_duration = duration;
+  return;
+}
+
+
+void gui_MarkDirty(IN rectangle_t& region)
+{
+  rectangle_t clipped_region = region;
+  uint8_t index;
+
+  if (
+    region.xpos >= LCD_WIDTH || region.ypos >= LCD_HEIGHT
+    || region.width == 0 || region.height == 0
+  )
+    return;
+
+  if (clipped_region.xpos + clipped_region.width > LCD_WIDTH)
+    clipped_region.width = LCD_WIDTH - clipped_region.xpos;
+
+  if (clipped_region.ypos + clipped_region.height > LCD_HEIGHT)
+    clipped_region.height = LCD_HEIGHT - clipped_region.ypos;
+
+  for (index = 0; index < num_dirty_regions; index++)
+  {
+    if (do_regions_touch(clipped_region, dirty_regions[index]))
+    {
+      merge_region_into_region(clipped_region, dirty_regions[index]);
+      return;
+    }
+  }
+
+  if (num_dirty_regions == MAX_NUM_DIRTY_REGIONS)
   {
-    gfx_BlitLines(gfx_buffer, ypos, 1);
-    delay(1);
+    for (index = 1; index < num_dirty_regions; index++)
+      merge_region_into_region(dirty_regions[index], dirty_regions[0]);
+
+    merge_region_into_region(clipped_region, dirty_regions[0]);
+    num_dirty_regions = 1;
+    return;
   }
 
-  gfx_BlitLines(gfx_buffer, 0, 1);
-  delay(50);
+  dirty_regions[num_dirty_regions] = clipped_region;
+  num_dirty_regions++;
+  return;
+}
+
+
+void gui_MarkScreenDirty()
+{
+  dirty_regions[0].xpos = 0;
+  dirty_regions[0].ypos = 0;
+  dirty_regions[0].width = LCD_WIDTH;
+  dirty_regions[0].height = LCD_HEIGHT;
+  num_dirty_regions = 1;
   return;
 }
 
 
+void gui_BlitDirtyRegions()
+{
+  rectangle_t overlay;
+  bool is_overlay_drawn = false;
+
+  num_bytes_blitted = 0;
+
+  if (update_notifications())
+  {
+    get_notification_overlay(overlay);
+    draw_notification_overlay(overlay);
+    is_overlay_drawn = true;
+  }
+
+  for (uint8_t index = 0; index < num_dirty_regions; index++)
+  {
+    const rectangle_t& region = dirty_regions[index];
+
+    gfx_BlitRectangle(
+      gfx_buffer, region.xpos, region.ypos, region.width, region.height
+    );
+    num_bytes_blitted += region.width * region.height;
+  }
+
+  num_dirty_regions = 0;
+
+  if (is_overlay_drawn)
+    remove_notification_overlay(overlay);
+
+  return;
+}
+
+
+uint24_t gui_GetNumBytesBlitted()
+{
+  return num_bytes_blitted;
+}
+
+
 // ============================================================================
 // STATIC FUNCTION DEFINITIONS
 // ============================================================================
@@ -906,60 +1523,537 @@ static unsigned int log10(IN unsigned int value)
 }
 
 
-static void draw_filled_rectangle(IN rectangle_t& rectangle)
+static bool is_atlas_character(IN char character)
 {
-  gfx_FillRectangle_NoClip(
-    rectangle.xpos, rectangle.ypos, rectangle.width, rectangle.height
+  return (
+    character >= FIRST_ATLAS_CHARACTER && character <= LAST_ATLAS_CHARACTER
+  );
+}
+
+
+// Builds the glyph from graphx's own 8 by 8 image of the character: the
+// shadow is the image moved one pixel right and down in black, and the
+// character is the image itself in white on top.
+static gfx_sprite_t* get_atlas_glyph(IN char character)
+{
+  gfx_sprite_t* glyph = (gfx_sprite_t*)font_atlas[
+    character - FIRST_ATLAS_CHARACTER
+  ];
+  const gfx_sprite_t* source;
+  uint8_t character_width;
+
+  if (glyph->width > 0)
+    return glyph;
+
+  // Only fonts at the normal scale use the atlas, so this changes nothing for
+  // the GuiText that asked for the glyph.
+  gfx_SetTextScale(1, 1);
+  gfx_SetTextFGColor(WHITE);
+  source = gfx_GetSpriteChar(character);
+  character_width = gfx_GetCharWidth(character);
+
+  assert(character_width < ATLAS_GLYPH_SIZE);
+
+  glyph->width = character_width + 1;
+  glyph->height = ATLAS_GLYPH_SIZE;
+  memset(glyph->data, TRANSPARENT, glyph->width * glyph->height);
+
+  for (uint8_t ypos = 0; ypos < GFX_DEFAULT_FONT_HEIGHT; ypos++)
+  {
+    for (uint8_t xpos = 0; xpos < character_width; xpos++)
+    {
+      if (source->data[(ypos * source->width) + xpos] == WHITE)
+        glyph->data[((ypos + 1) * glyph->width) + xpos + 1] = BLACK;
+    }
+  }
+
+  for (uint8_t ypos = 0; ypos < GFX_DEFAULT_FONT_HEIGHT; ypos++)
+  {
+    for (uint8_t xpos = 0; xpos < character_width; xpos++)
+    {
+      if (source->data[(ypos * source->width) + xpos] == WHITE)
+        glyph->data[(ypos * glyph->width) + xpos] = WHITE;
+    }
+  }
+
+  return glyph;
+}
+
+
+// Regions that only share an edge count as touching so that a string, which
+// is marked one character at a time, becomes a single region.
+static bool do_regions_touch(
+  IN rectangle_t& first_region, IN rectangle_t& second_region
+)
+{
+  return (
+    first_region.xpos <= second_region.xpos + second_region.width
+    && second_region.xpos <= first_region.xpos + first_region.width
+    && first_region.ypos <= second_region.ypos + second_region.height
+    && second_region.ypos <= first_region.ypos + first_region.height
   );
+}
+
+
+// Grows the destination region until it also covers the source region.
+static void merge_region_into_region(
+  IN rectangle_t& source, MOD rectangle_t& destination
+)
+{
+  const uint24_t RIGHT = (
+    source.xpos + source.width > destination.xpos + destination.width
+    ? source.xpos + source.width
+    : destination.xpos + destination.width
+  );
+  const uint24_t BOTTOM = (
+    source.ypos + source.height > destination.ypos + destination.height
+    ? source.ypos + source.height
+    : destination.ypos + destination.height
+  );
+
+  if (source.xpos < destination.xpos)
+    destination.xpos = source.xpos;
+
+  if (source.ypos < destination.ypos)
+    destination.ypos = source.ypos;
+
+  destination.width = RIGHT - destination.xpos;
+  destination.height = BOTTOM - destination.ypos;
   return;
 }
 
 
-static void draw_filled_rounded_rectangle(
-  IN rectangle_t& rectangle, IN uint8_t corner_radius
+static const uint8_t* get_corner_insets(IN uint8_t corner_radius)
+{
+  uint8_t* insets = corner_insets[corner_radius];
+  uint24_t distance_squared;
+  uint24_t radius_squared = corner_radius * corner_radius;
+  uint8_t half_width;
+
+  assert(corner_radius <= MAX_CORNER_RADIUS);
+
+  if (has_corner_insets[corner_radius])
+    return insets;
+
+  for (uint8_t row = 0; row < corner_radius; row++)
+  {
+    distance_squared = (corner_radius - row) * (corner_radius - row);
+    half_width = 0;
+
+    while (
+      ((half_width + 1) * (half_width + 1)) + distance_squared
+      <= radius_squared
+    )
+      half_width++;
+
+    insets[row] = corner_radius - half_width;
+  }
+
+  has_corner_insets[corner_radius] = true;
+  return insets;
+}
+
+
+static void fill_span(
+  IN uint8_t ypos, IN uint24_t left, IN uint24_t right, IN uint8_t color
 )
 {
-  gfx_FillCircle_NoClip(
-    rectangle.xpos + corner_radius,
-    rectangle.ypos + corner_radius,
-    corner_radius
+  memset(&gfx_vbuffer[ypos][left], color, right - left + 1);
+  return;
+}
+
+
+// Draws the layers, given from the bottom up, one scanline at a time. Each
+// scanline is filled from the top layer down, and a lower layer only fills
+// the parts of its span that the layers above it have not already covered, so
+// no pixel is written more than once where the layers overlap.
+static void draw_layers(IN layer_t* layers, IN uint8_t num_layers)
+{
+  rectangle_t region = layers[0].rectangle;
+  rectangle_t extent;
+  span_t covered_spans[MAX_NUM_LAYERS];
+  uint8_t num_covered_spans;
+  span_t span;
+  uint24_t xpos;
+  uint8_t row;
+  uint8_t inset;
+
+  assert(num_layers <= MAX_NUM_LAYERS);
+
+  for (uint8_t index = 0; index < num_layers; index++)
+  {
+    extent = layers[index].rectangle;
+
+    if (layers[index].corner_radius > 0)
+    {
+      extent.width++;
+      extent.height++;
+    }
+
+    merge_region_into_region(extent, region);
+  }
+
+  assert(region.xpos + region.width <= LCD_WIDTH);
+  assert(region.ypos + region.height <= LCD_HEIGHT);
+
+  for (
+    uint8_t ypos = region.ypos; ypos < region.ypos + region.height; ypos++
+  )
+  {
+    num_covered_spans = 0;
+
+    for (uint8_t index = num_layers; index-- > 0;)
+    {
+      const layer_t& layer = layers[index];
+      const uint8_t EXTRA = (layer.corner_radius > 0 ? 1 : 0);
+      const uint8_t LAST_ROW = layer.rectangle.height - 1 + EXTRA;
+
+      if (
+        layer.rectangle.width == 0 || layer.rectangle.height == 0
+        || ypos < layer.rectangle.ypos
+        || ypos > layer.rectangle.ypos + LAST_ROW
+      )
+        continue;
+
+      span.left = layer.rectangle.xpos;
+      span.right = layer.rectangle.xpos + layer.rectangle.width - 1 + EXTRA;
+      row = ypos - layer.rectangle.ypos;
+
+      if (LAST_ROW - row < row)
+        row = LAST_ROW - row;
+
+      if (row < layer.corner_radius)
+      {
+        inset = get_corner_insets(layer.corner_radius)[row];
+
+        if (span.right < span.left + (2 * inset))
+          continue;
+
+        span.left += inset;
+        span.right -= inset;
+      }
+
+      // The covered spans are kept sorted and apart, so the gaps between
+      // them are the only parts of the span left to fill.
+      xpos = span.left;
+
+      for (uint8_t cover = 0; cover < num_covered_spans; cover++)
+      {
+        if (covered_spans[cover].right < xpos)
+          continue;
+
+        if (covered_spans[cover].left > span.right)
+          break;
+
+        if (covered_spans[cover].left > xpos)
+          fill_span(ypos, xpos, covered_spans[cover].left - 1, layer.color);
+
+        xpos = covered_spans[cover].right + 1;
+      }
+
+      if (xpos <= span.right)
+        fill_span(ypos, xpos, span.right, layer.color);
+
+      add_covered_span(span, covered_spans, num_covered_spans);
+    }
+  }
+
+  gui_MarkDirty(region);
+  return;
+}
+
+
+// Adds the span to the sorted list of covered spans, merging it with any
+// spans that it overlaps or touches.
+static void add_covered_span(
+  IN span_t& span, MOD span_t* covered_spans, MOD uint8_t& num_covered_spans
+)
+{
+  span_t merged_span = span;
+  uint8_t num_kept_spans = 0;
+  uint8_t index;
+
+  for (index = 0; index < num_covered_spans; index++)
+  {
+    if (
+      covered_spans[index].right + 1 < merged_span.left
+      || covered_spans[index].left > merged_span.right + 1
+    )
+    {
+      covered_spans[num_kept_spans] = covered_spans[index];
+      num_kept_spans++;
+    }
+    else
+    {
+      if (covered_spans[index].left < merged_span.left)
+        merged_span.left = covered_spans[index].left;
+
+      if (covered_spans[index].right > merged_span.right)
+        merged_span.right = covered_spans[index].right;
+    }
+  }
+
+  index = num_kept_spans;
+
+  while (index > 0 && covered_spans[index - 1].left > merged_span.left)
+  {
+    covered_spans[index] = covered_spans[index - 1];
+    index--;
+  }
+
+  covered_spans[index] = merged_span;
+  num_covered_spans = num_kept_spans + 1;
+  return;
+}
+
+
+// Builds the scanlines of a background the first time it is drawn after a
+// different one, then copies them down the whole buffer.
+static void draw_background(IN background_t new_background)
+{
+  rectangle_t screen = {
+    .xpos = 0,
+    .ypos = 0,
+    .width = LCD_WIDTH,
+    .height = LCD_HEIGHT
+  };
+
+  if (new_background != background)
+  {
+    for (uint8_t row = 0; row < 2; row++)
+    {
+      for (uint24_t xpos = 0; xpos < LCD_WIDTH; xpos++)
+      {
+        background_scanlines[row][xpos] = (
+          (xpos / BACKGROUND_CELL_SIZE) % 2 == row
+          ? DARK_MED_BLUE
+          : DARK_BLUE
+        );
+      }
+
+      if (new_background == GAME_SCREEN_BACKGROUND)
+      {
+        memset(&background_scanlines[row][30], BLACK, 2);
+        background_scanlines[row][32] = WHITE;
+        memset(&background_scanlines[row][33], DARK_MED_BLUE, 254);
+        background_scanlines[row][288] = WHITE;
+        memset(&background_scanlines[row][289], BLACK, 2);
+      }
+    }
+
+    background = new_background;
+  }
+
+  gui_RestoreBackground(screen);
+  gui_MarkScreenDirty();
+  return;
+}
+
+
+// Blits however many lines from the bottom up the time since the start calls
+// for, in as few calls as the frame rate of the loop allows. A key that goes
+// down part way through shows the rest at once, and is then ignored until it
+// is released so that it does not also act on the screen it revealed. Keys
+// that were already down at the start do not count until they are released,
+// except for a key that cut short the transition before, which cuts short
+// this one as well.
+static void reveal_back_buffer()
+{
+  const ticks_t START_TIMESTAMP = SystemClock::now();
+
+  uint24_t num_lines_revealed = 0;
+  uint24_t num_lines_due;
+  ticks_t elapsed_time;
+  bool is_key_held_from_before;
+
+  Keypad::update_state();
+  is_key_held_from_before = Keypad::is_any_key_down();
+
+  while (num_lines_revealed < LCD_HEIGHT)
+  {
+    elapsed_time = SystemClock::now() - START_TIMESTAMP;
+
+    if (elapsed_time >= transition_duration)
+    {
+      num_lines_due = LCD_HEIGHT;
+    }
+    else
+    {
+      num_lines_due = (uint24_t)(
+        (elapsed_time * LCD_HEIGHT) / transition_duration
+      );
+    }
+
+    Keypad::update_state();
+
+    if (Keypad::is_ignoring_until_released())
+    {
+      num_lines_due = LCD_HEIGHT;
+    }
+    else if (!Keypad::is_any_key_down())
+    {
+      is_key_held_from_before = false;
+    }
+    else if (!is_key_held_from_before)
+    {
+      Keypad::ignore_until_released();
+      num_lines_due = LCD_HEIGHT;
+    }
+
+    if (num_lines_due > num_lines_revealed)
+    {
+      gfx_BlitLines(
+        gfx_buffer,
+        LCD_HEIGHT - num_lines_due,
+        num_lines_due - num_lines_revealed
+      );
+      num_lines_revealed = num_lines_due;
+    }
+  }
+
+  return;
+}
+
+
+// Moves the notifications along and tells whether the first one has to be
+// drawn for this blit: when more of it is revealed, or when part of it is
+// about to be blitted over.
+static bool update_notifications()
+{
+  rectangle_t overlay;
+  ticks_t elapsed_time;
+  uint24_t num_columns;
+
+  if (num_notifications == 0)
+    return false;
+
+  elapsed_time = SystemClock::now() - notification_timestamp;
+
+  if (elapsed_time >= NOTIFICATION_TIMEOUT)
+  {
+    get_notification_overlay(overlay);
+    gui_MarkDirty(overlay);
+    free_notification_underlay();
+
+    first_notification_index = (
+      (first_notification_index + 1) % MAX_NUM_QUEUED_NOTIFICATIONS
+    );
+    num_notifications--;
+
+    if (num_notifications == 0)
+      return false;
+
+    notification_timestamp = SystemClock::now();
+    num_notification_columns_shown = 0;
+    elapsed_time = 0;
+  }
+
+  get_notification_overlay(overlay);
+
+  // Without room to save what is under it, the notification is not shown.
+  if (notification_underlay == NULL)
+  {
+    notification_underlay = (uint8_t*)malloc(
+      overlay.width * NOTIFICATION_HEIGHT
+    );
+
+    if (notification_underlay == NULL)
+      return false;
+  }
+
+  num_columns = spr_notification_icon->width + (uint24_t)(
+    (elapsed_time * NOTIFICATION_REVEAL_RATE) / TICKS_PER_MILLISECOND
   );
 
-  gfx_FillCircle_NoClip(
-    rectangle.xpos + rectangle.width - corner_radius,
-    rectangle.ypos + corner_radius,
-    corner_radius
+  if (num_columns > overlay.width)
+    num_columns = overlay.width;
+
+  if (num_columns != num_notification_columns_shown)
+  {
+    num_notification_columns_shown = num_columns;
+    gui_MarkDirty(overlay);
+    return true;
+  }
+
+  for (uint8_t index = 0; index < num_dirty_regions; index++)
+  {
+    if (do_regions_touch(dirty_regions[index], overlay))
+    {
+      gui_MarkDirty(overlay);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+
+// Saves the back buffer under the overlay, draws the first notification over
+// it, and puts back the columns of it that are not revealed yet.
+static void draw_notification_overlay(IN rectangle_t& overlay)
+{
+  const uint24_t NUM_HIDDEN_COLUMNS = (
+    overlay.width - num_notification_columns_shown
   );
 
-  if (corner_radius <= (rectangle.height / 2))
+  for (uint8_t line = 0; line < NOTIFICATION_HEIGHT; line++)
   {
-    gfx_FillCircle_NoClip(
-      rectangle.xpos + corner_radius,
-      rectangle.ypos + rectangle.height - corner_radius,
-      corner_radius
+    memcpy(
+      &notification_underlay[line * overlay.width],
+      &gfx_vbuffer[NOTIFICATION_YPOS + line][overlay.xpos],
+      overlay.width
     );
+  }
+
+  notifications[first_notification_index].draw();
+
+  if (NUM_HIDDEN_COLUMNS == 0)
+    return;
 
-    gfx_FillCircle_NoClip(
-      rectangle.xpos + rectangle.width - corner_radius,
-      rectangle.ypos + rectangle.height - corner_radius,
-      corner_radius
+  for (uint8_t line = 0; line < NOTIFICATION_HEIGHT; line++)
+  {
+    memcpy(
+      &gfx_vbuffer[NOTIFICATION_YPOS + line][num_notification_columns_shown],
+      &notification_underlay[
+        (line * overlay.width) + num_notification_columns_shown
+      ],
+      NUM_HIDDEN_COLUMNS
     );
+  }
+
+  return;
+}
+
 
-    gfx_FillRectangle_NoClip(
-      rectangle.xpos,
-      rectangle.ypos + corner_radius,
-      rectangle.width + 1,
-      rectangle.height - (2 * corner_radius)
+static void remove_notification_overlay(IN rectangle_t& overlay)
+{
+  for (uint8_t line = 0; line < NOTIFICATION_HEIGHT; line++)
+  {
+    memcpy(
+      &gfx_vbuffer[NOTIFICATION_YPOS + line][overlay.xpos],
+      &notification_underlay[line * overlay.width],
+      overlay.width
     );
   }
 
-  gfx_FillRectangle_NoClip(
-    rectangle.xpos + corner_radius,
-    rectangle.ypos,
-    rectangle.width - (2 * corner_radius),
-    rectangle.height + 1
-  );
+  return;
+}
 
+
+static void get_notification_overlay(OUT rectangle_t& overlay)
+{
+  overlay.xpos = 0;
+  overlay.ypos = NOTIFICATION_YPOS;
+  overlay.width = notifications[first_notification_index].get_width();
+  overlay.height = NOTIFICATION_HEIGHT;
+  return;
+}
+
+
+static void free_notification_underlay()
+{
+  free(notification_underlay);
+  notification_underlay = NULL;
   return;
 }
 
@@ -1012,14 +2106,30 @@ static void draw_button(IN button_attributes_t& attributes)
     .height = (uint8_t)(button_height - (button_height / 2) - 1),
   };
 
-  gfx_SetColor(BLACK);
-  draw_filled_rounded_rectangle(shadow_rectangle, corner_radius);
-  gfx_SetColor(attributes.highlight_color);
-  draw_filled_rounded_rectangle(border_rectangle, corner_radius);
-  gfx_SetColor(attributes.main_color);
-  draw_filled_rounded_rectangle(inner_rectangle, corner_radius);
-  gfx_SetColor(attributes.inner_shadow_color);
-  draw_filled_rounded_rectangle(inner_shadow_rectangle, 5);
+  layer_t layers[4] = {
+    {
+      .rectangle = shadow_rectangle,
+      .color = BLACK,
+      .corner_radius = corner_radius
+    },
+    {
+      .rectangle = border_rectangle,
+      .color = attributes.highlight_color,
+      .corner_radius = corner_radius
+    },
+    {
+      .rectangle = inner_rectangle,
+      .color = attributes.main_color,
+      .corner_radius = corner_radius
+    },
+    {
+      .rectangle = inner_shadow_rectangle,
+      .color = attributes.inner_shadow_color,
+      .corner_radius = 5
+    }
+  };
+
+  draw_layers(layers, 4);
 
   gfx_SetTextBGColor(TRANSPARENT);
   gfx_SetTextFGColor(BLACK);
@@ -1081,9 +2191,10 @@ static void draw_gameplay_option(
 
   text.set_font(GuiText::GAMEPLAY_OPTION_TITLE);
   text.set_xpos(
-    container.get_xpos() + ((CONTAINER_WIDTH - gfx_GetStringWidth(title)) / 2)
+    container.get_xpos() + 1
+    + ((CONTAINER_WIDTH - gfx_GetStringWidth(title)) / 2)
   );
-  text.set_ypos(container.get_ypos() + 8);
+  text.set_ypos(container.get_ypos() + 9);
   text.draw_string(title);
   return;
 }
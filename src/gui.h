@@ -2,6 +2,9 @@
 #define GUI_H
 
 
+#include <graphx.h>
+
+#include "systemclock.h"
 #include "typehints.h"
 
 
@@ -66,6 +69,7 @@ class GuiText
     };
 
     uint8_t get_font_height() const;
+    uint24_t get_string_width(IN char* string) const;
 
     void draw_string(IN char* string);
     void draw_centered_string(IN char* string);
@@ -73,6 +77,7 @@ class GuiText
     void draw_unsigned_int(IN unsigned int integer);
 
     void set_font(IN font_style_t font_style);
+    void set_color(IN uint8_t color);
     void set_xpos(IN uint24_t xpos);
     void set_ypos(IN uint8_t ypos);
 
@@ -84,6 +89,8 @@ class GuiText
     uint8_t z_index;
     uint8_t horizontal_scale;
     uint8_t vertical_scale;
+
+    bool uses_font_atlas() const;
 };
 
 
@@ -121,7 +128,7 @@ class DecoratedRectangle : public Rectangle
   public:
     DecoratedRectangle();
 
-    void draw();
+    void draw() const;
 
     void set_border_color(IN uint8_t border_color);
     void set_border_radius(IN uint8_t border_radius);
@@ -161,13 +168,17 @@ class InputField
 };
 
 
+// A message in a box next to the notification icon at the top left of the
+// screen. Screens do not draw these themselves; gui_QueueNotification() shows
+// them over whatever the screen has drawn.
 class Notification
 {
   public:
+    Notification();
     Notification(IN char* message);
 
+    uint24_t get_width() const;
     void draw();
-    void blit();
 
   private:
     static const uint8_t MAX_MESSAGE_LENGTH = 30;
@@ -175,7 +186,133 @@ class Notification
     GuiText text;
     char message[MAX_MESSAGE_LENGTH + 1] = { '\0' };
     rectangle_t container;
-    uint24_t animation_index;
+};
+
+
+// A node of a retained widget tree. A screen builds its tree and lays it out
+// once, then calls render() every frame. Only the nodes that have been
+// invalidated since the last render() are drawn again, along with everything
+// under them, since a node paints over its children. What the clean nodes
+// drew last stays in the back buffer, so the screen should be shown with
+// gui_BlitDirtyRegions() rather than by swapping buffers. A node is drawn
+// again every time it is invalidated, so draw_self() must leave the node as
+// it found it.
+class Widget
+{
+  public:
+    Widget();
+    virtual ~Widget() {}
+
+    void add_child(MOD Widget& child);
+    void invalidate();
+    void render();
+
+  protected:
+    virtual void draw_self();
+
+  private:
+    Widget* first_child;
+    Widget* next_sibling;
+    bool needs_redraw;
+
+    void render_tree(IN bool must_draw);
+};
+
+
+// The checkered background, with a menu title if one is given.
+class ScreenWidget : public Widget
+{
+  public:
+    ScreenWidget(IN char* title = NULL);
+
+  protected:
+    void draw_self();
+
+  private:
+    const char* title;
+};
+
+
+class SpriteWidget : public Widget
+{
+  public:
+    SpriteWidget(
+      IN gfx_sprite_t* sprite,
+      IN uint24_t xpos,
+      IN uint8_t ypos,
+      IN uint8_t horizontal_scale,
+      IN uint8_t vertical_scale
+    );
+
+  protected:
+    void draw_self();
+
+  private:
+    const gfx_sprite_t* sprite;
+    rectangle_t region;
+    uint8_t horizontal_scale;
+    uint8_t vertical_scale;
+};
+
+
+class ButtonWidget : public Widget
+{
+  public:
+    ButtonWidget();
+
+    void set_title(IN char* title);
+    void set_ypos(IN uint8_t ypos);
+    void set_selected(IN bool selected);
+
+  protected:
+    void draw_self();
+
+  private:
+    const char* title;
+    uint8_t ypos;
+    bool selected;
+};
+
+
+// A line of text centered on the screen.
+class TextWidget : public Widget
+{
+  public:
+    TextWidget();
+
+    void set_string(IN char* string);
+    void set_font(IN GuiText::font_style_t font_style);
+    void set_ypos(IN uint8_t ypos);
+
+  protected:
+    void draw_self();
+
+  private:
+    const char* string;
+    GuiText::font_style_t font_style;
+    uint8_t ypos;
+};
+
+
+class ContainerWidget : public Widget, public Container
+{
+  protected:
+    void draw_self();
+};
+
+
+class InputFieldWidget : public Widget, public InputField
+{
+  public:
+    InputFieldWidget(IN uint8_t ypos, IN uint24_t width);
+
+    void set_input(IN char* input);
+
+  protected:
+    void draw_self();
+
+  private:
+    const char* input;
 };
 
 
@@ -193,15 +330,37 @@ void gui_DrawButton(IN char* title, IN uint8_t ypos);
 void gui_DrawButtonSelected(IN char* title, IN uint8_t ypos);
 void gui_DrawMenuTitle(IN char* title);
 void gui_Notification(IN char* message);
+void gui_QueueNotification(IN char* message);
+bool gui_IsNotificationShowing();
+void gui_ClearNotifications();
 void gui_DrawPageNumberIndicator(
   IN uint8_t num_pages, IN uint8_t current_page_num
 );
 void gui_DrawGameplayOption(IN char* title, IN point_t& origin);
 void gui_DrawGameplayOptionSelected(IN char* title, IN point_t& origin);
 void gui_DrawCheckeredBackground();
+void gui_DrawGameScreenBackground();
+void gui_RestoreBackground(IN rectangle_t& region);
+
+// Transitions take a fixed time, whatever the speed of the calculator, and
+// can be cut short with any key. A duration of zero turns them off.
+#define DEFAULT_TRANSITION_DURATION (TICKS_PER_SECOND / 5)
 
 void gui_TransitionIn();
 void gui_TransitionOut();
+void gui_SetTransitionDuration(IN ticks_t duration);
+
+// The widgets and drawing functions above mark the parts of the back buffer
+// that they draw to. gui_BlitDirtyRegions() copies only those parts to the
+// screen, and gui_GetNumBytesBlitted() tells how many bytes its last call
+// copied. Anything drawn with graphx directly must be marked with
+// gui_MarkDirty(). gui_BlitDirtyRegions() also shows queued notifications,
+// so a screen that shows them must blit every frame while
+// gui_IsNotificationShowing() is true.
+void gui_MarkDirty(IN rectangle_t& region);
+void gui_MarkScreenDirty();
+void gui_BlitDirtyRegions();
+uint24_t gui_GetNumBytesBlitted();
 
 
 #endif
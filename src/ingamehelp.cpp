@@ -42,7 +42,48 @@
 //      ANAGRAM_GAMEPLAY     = (1 << 4)
 //    };
 //
-//   The same parser can be used for for v0, v1, and v2 because each new
+// Version 3
+//
+//    enum HELP_FLAG : uint8_t
+//    {
+//      MAIN_MENU            = (1 << 0),
+//      WORD_CODE_ENTRY_MENU = (1 << 1),
+//      ORIGINAL_GAMEPLAY    = (1 << 2),
+//      RUSH_GAMEPLAY        = (1 << 3),
+//      ANAGRAM_GAMEPLAY     = (1 << 4),
+//      ADVERSARIAL_GAMEPLAY = (1 << 5)
+//    };
+//
+// Version 4
+//
+//    enum HELP_FLAG : uint8_t
+//    {
+//      MAIN_MENU            = (1 << 0),
+//      WORD_CODE_ENTRY_MENU = (1 << 1),
+//      ORIGINAL_GAMEPLAY    = (1 << 2),
+//      RUSH_GAMEPLAY        = (1 << 3),
+//      ANAGRAM_GAMEPLAY     = (1 << 4),
+//      ADVERSARIAL_GAMEPLAY = (1 << 5),
+//      QUAD_GAMEPLAY        = (1 << 6)
+//    };
+//
+// Version 5
+//
+//    enum HELP_FLAG : uint8_t
+//    {
+//      MAIN_MENU            = (1 << 0),
+//      WORD_CODE_ENTRY_MENU = (1 << 1),
+//      ORIGINAL_GAMEPLAY    = (1 << 2),
+//      RUSH_GAMEPLAY        = (1 << 3),
+//      ANAGRAM_GAMEPLAY     = (1 << 4),
+//      ADVERSARIAL_GAMEPLAY = (1 << 5),
+//      QUAD_GAMEPLAY        = (1 << 6),
+//      LADDER_GAMEPLAY      = (1 << 7)
+//    };
+//
+//   `shown_help_flags` has no unused bits left after v5.
+//
+//   The same parser can be used for for v0 through v5 because each new
 // version simply reduced the number of unused bits in `shown_help_flags`.
 //
 
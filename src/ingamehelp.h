@@ -22,13 +22,16 @@ class InGameHelp
       WORD_CODE_ENTRY_MENU = (1 << 1),
       ORIGINAL_GAMEPLAY    = (1 << 2),
       RUSH_GAMEPLAY        = (1 << 3),
-      ANAGRAM_GAMEPLAY     = (1 << 4)
+      ANAGRAM_GAMEPLAY     = (1 << 4),
+      ADVERSARIAL_GAMEPLAY = (1 << 5),
+      QUAD_GAMEPLAY        = (1 << 6),
+      LADDER_GAMEPLAY      = (1 << 7)
     };
 
     static bool must_show_help_for(IN HELP_FLAG help_flag);
 
   private:
-    const uint8_t LATEST_VERSION = 2;
+    const uint8_t LATEST_VERSION = 5;
     static InGameHelp instance;
     static uint8_t version;
     static uint8_t shown_help_flags;
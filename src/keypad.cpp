@@ -1,3 +1,6 @@
+#include <string.h>
+
+#include "framescheduler.h"
 #include "keypad.h"
 
 
@@ -32,13 +35,24 @@ void Keypad::update_state()
     Keypad::state[index] = kb_Data[index];
   }
 
-  if (Keypad::timestamp_delta)
+  // Ignored keys look as if they were never down, so that letting go of them
+  // is not a release either.
+  if (Keypad::is_ignoring_keys)
+  {
+    Keypad::is_ignoring_keys = is_any_key_down();
+    memset(Keypad::previous_state, 0, sizeof Keypad::previous_state);
+    memset(Keypad::state, 0, sizeof Keypad::state);
+  }
+
+  // A repeat only takes effect on the next frame, so that every check of the
+  // same key within a frame gives the same answer.
+  if (Keypad::is_repeat_pending)
   {
-    Keypad::prev_timestamp = Keypad::timestamp + Keypad::timestamp_delta;
-    Keypad::timestamp_delta = 0;
+    Keypad::repeat_deadline = Keypad::next_repeat_deadline;
+    Keypad::is_repeat_pending = false;
   }
 
-  Keypad::timestamp = clock();
+  Keypad::timestamp = SystemClock::now();
 
   return;
 }
@@ -55,6 +69,19 @@ bool Keypad::is_any_key_down()
 }
 
 
+// True if no key is down now or was down on the last update, in which case no
+// other key check can report anything and a loop can skip its frame.
+bool Keypad::is_idle()
+{
+  uint8_t sum = 0;
+
+  for (uint8_t index = 1; index < 8; index++)
+    sum |= Keypad::state[index] | Keypad::previous_state[index];
+
+  return !sum;
+}
+
+
 bool Keypad::is_down(IN kb_lkey_t key)
 {
   return (Keypad::state[key >> 8] & (key % 256));
@@ -105,22 +132,41 @@ bool Keypad::was_down_exclusive(IN kb_lkey_t key)
 }
 
 
+// Repeats are spaced from the last repeat's deadline rather than from the frame
+// that noticed it, so frame times do not show up as uneven repeats. After a
+// long stall, the next repeat is spaced from the current frame instead of
+// firing several times in a row.
 bool Keypad::is_down_repeating(IN kb_lkey_t key)
 {
-  const uint24_t INITIAL_PAUSE = CLOCKS_PER_SEC / 2;
-  const uint24_t DELAY = CLOCKS_PER_SEC / 12;
+  const ticks_t INITIAL_PAUSE = TICKS_PER_SECOND / 2;
+  const ticks_t DELAY = TICKS_PER_SECOND / 12;
 
   if (was_down_exclusive(key))
   {
-    if (is_down_exclusive(key) && Keypad::timestamp >= Keypad::prev_timestamp)
+    if (
+      is_down_exclusive(key)
+      && SystemClock::has_reached(Keypad::timestamp, Keypad::repeat_deadline)
+    )
     {
-      Keypad::timestamp_delta = DELAY;
+      Keypad::next_repeat_deadline = Keypad::repeat_deadline + DELAY;
+
+      if (
+        SystemClock::has_reached(
+          Keypad::timestamp, Keypad::next_repeat_deadline
+        )
+      )
+      {
+        Keypad::next_repeat_deadline = Keypad::timestamp + DELAY;
+      }
+
+      Keypad::is_repeat_pending = true;
       return true;
     }
   }
   else if (is_down_exclusive(key))
   {
-    Keypad::timestamp_delta = INITIAL_PAUSE;
+    Keypad::next_repeat_deadline = Keypad::timestamp + INITIAL_PAUSE;
+    Keypad::is_repeat_pending = true;
     return true;
   }
 
@@ -154,13 +200,29 @@ bool Keypad::was_released_exclusive(IN kb_lkey_t key)
 void Keypad::block_until_any_key_released()
 {
   do {
-    Keypad::update_state();
+    FrameScheduler::start_frame();
   } while (!was_any_key_released());
 
   return;
 }
 
 
+// Every key that is down now reads as up until all keys have been released.
+// Used when a key press has already been acted on outside of the usual key
+// checks.
+void Keypad::ignore_until_released()
+{
+  Keypad::is_ignoring_keys = is_any_key_down();
+  return;
+}
+
+
+bool Keypad::is_ignoring_until_released()
+{
+  return Keypad::is_ignoring_keys;
+}
+
+
 kb_lkey_t Keypad::get_only_key_down()
 {
   kb_lkey_t key = 0;
@@ -200,9 +262,11 @@ bool Keypad::get_character_from_keymap(
 Keypad Keypad::instance;
 uint8_t Keypad::previous_state[8] = { 0 };
 uint8_t Keypad::state[8] = { 0 };
-clock_t Keypad::prev_timestamp = 0;
-clock_t Keypad::timestamp = clock();
-clock_t Keypad::timestamp_delta = 0;
+ticks_t Keypad::timestamp = 0;
+ticks_t Keypad::repeat_deadline = 0;
+ticks_t Keypad::next_repeat_deadline = 0;
+bool Keypad::is_repeat_pending = false;
+bool Keypad::is_ignoring_keys = false;
 
 
 Keypad::Keypad()
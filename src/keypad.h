@@ -3,8 +3,8 @@
 
 
 #include <keypadc.h>
-#include <time.h>
 
+#include "systemclock.h"
 #include "typehints.h"
 
 
@@ -15,6 +15,7 @@ class Keypad
   public:
     static void update_state();
     static bool is_any_key_down();
+    static bool is_idle();
     static bool is_down(IN kb_lkey_t key);
     static bool is_down_exclusive(IN kb_lkey_t key);
     static bool was_down(IN kb_lkey_t key);
@@ -24,6 +25,8 @@ class Keypad
     static bool was_released(IN kb_lkey_t key);
     static bool was_released_exclusive(IN kb_lkey_t key);
     static void block_until_any_key_released();
+    static void ignore_until_released();
+    static bool is_ignoring_until_released();
     static kb_lkey_t get_only_key_down();
     static bool get_character_from_keymap(
       IN keymap_t keymap, OUT char& character
@@ -33,9 +36,11 @@ class Keypad
     static Keypad instance;
     static uint8_t previous_state[8];
     static uint8_t state[8];
-    static clock_t prev_timestamp;
-    static clock_t timestamp;
-    static clock_t timestamp_delta;
+    static ticks_t timestamp;
+    static ticks_t repeat_deadline;
+    static ticks_t next_repeat_deadline;
+    static bool is_repeat_pending;
+    static bool is_ignoring_keys;
 
     Keypad();
 };
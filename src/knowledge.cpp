@@ -0,0 +1,230 @@
+#include <string.h>
+
+#include "knowledge.h"
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+#define ALL_POSITIONS_ALLOWED ((1 << WORD_LENGTH) - 1)
+
+
+// ============================================================================
+// STATIC FUNCTION DECLARATIONS
+// ============================================================================
+
+
+static uint8_t count_letter_in_word(IN Word& word, IN char letter);
+static bool is_first_occurrence(IN Word& word, IN uint8_t index);
+
+
+// ============================================================================
+// CLASS KnowledgeState FUNCTION DEFINITIONS
+// ============================================================================
+
+
+KnowledgeState::KnowledgeState()
+{
+  reset();
+  return;
+}
+
+
+void KnowledgeState::reset()
+{
+  memset(state.min_counts, 0, ALPHABET_LENGTH);
+  memset(state.max_counts, WORD_LENGTH, ALPHABET_LENGTH);
+  memset(state.allowed_positions, ALL_POSITIONS_ALLOWED, ALPHABET_LENGTH);
+  memset(state.solved_letters, '\0', WORD_LENGTH);
+  state.placed_letters = 0;
+  state.total_min_count = 0;
+  return;
+}
+
+
+// Only the guess's own letters are visited, so the cost does not depend on the
+// size of the alphabet. UNEVALUATED positions reveal nothing and are skipped,
+// which lets callers pass on just part of an evaluation.
+void KnowledgeState::include_guess(
+  IN Word& guess, IN word_evaluation_t evaluation
+)
+{
+  uint8_t letter;
+  uint8_t num_found;
+  bool has_incorrect;
+
+  for (uint8_t index = 0; index < WORD_LENGTH; index++)
+  {
+    letter = guess[index] - 'A';
+
+    if (evaluation[index] == POSITION_AND_LETTER_CORRECT)
+    {
+      state.solved_letters[index] = guess[index];
+      state.placed_letters |= (1UL << letter);
+    }
+    else if (evaluation[index] != UNEVALUATED)
+    {
+      state.allowed_positions[letter] &= ~(1 << index);
+    }
+  }
+
+  for (uint8_t index = 0; index < WORD_LENGTH; index++)
+  {
+    if (!is_first_occurrence(guess, index))
+      continue;
+
+    letter = guess[index] - 'A';
+    num_found = 0;
+    has_incorrect = false;
+
+    for (uint8_t other_index = index; other_index < WORD_LENGTH; other_index++)
+    {
+      if (guess[other_index] == guess[index])
+      {
+        if (evaluation[other_index] == POSITION_AND_LETTER_INCORRECT)
+          has_incorrect = true;
+        else if (evaluation[other_index] != UNEVALUATED)
+          num_found++;
+      }
+    }
+
+    if (num_found > state.min_counts[letter])
+    {
+      state.total_min_count += num_found - state.min_counts[letter];
+      state.min_counts[letter] = num_found;
+    }
+
+    // A gray copy of a letter means the target has no more copies of it than
+    // the guess's green and orange ones.
+    if (has_incorrect && num_found < state.max_counts[letter])
+      state.max_counts[letter] = num_found;
+  }
+
+  return;
+}
+
+
+// Checks the Hard Mode rule: every placed letter is reused in place and every
+// letter known to be in the target is used at least as many times as known.
+bool KnowledgeState::satisfies_hard_mode(IN Word& guess) const
+{
+  uint8_t letter;
+  uint8_t count;
+  uint8_t num_required_found = 0;
+
+  for (uint8_t index = 0; index < WORD_LENGTH; index++)
+  {
+    if (
+      state.solved_letters[index] != '\0'
+      && state.solved_letters[index] != guess[index]
+    )
+    {
+      return false;
+    }
+
+    if (!is_first_occurrence(guess, index))
+      continue;
+
+    letter = guess[index] - 'A';
+    count = count_letter_in_word(guess, guess[index]);
+    num_required_found += (
+      count < state.min_counts[letter] ? count : state.min_counts[letter]
+    );
+  }
+
+  // Every required copy of every letter must be accounted for.
+  return num_required_found == state.total_min_count;
+}
+
+
+bool KnowledgeState::is_consistent(IN Word& word) const
+{
+  uint8_t letter;
+
+  if (!satisfies_hard_mode(word))
+    return false;
+
+  for (uint8_t index = 0; index < WORD_LENGTH; index++)
+  {
+    letter = word[index] - 'A';
+
+    if (!(state.allowed_positions[letter] & (1 << index)))
+      return false;
+
+    if (
+      is_first_occurrence(word, index)
+      && count_letter_in_word(word, word[index]) > state.max_counts[letter]
+    )
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+KnowledgeState::letter_status_t KnowledgeState::get_letter_status(
+  IN char letter
+) const
+{
+  const uint8_t INDEX = letter - 'A';
+
+  if (state.placed_letters & (1UL << INDEX))
+    return PLACED;
+
+  if (state.min_counts[INDEX] > 0)
+    return PRESENT;
+
+  if (state.max_counts[INDEX] == 0)
+    return ABSENT;
+
+  return UNKNOWN;
+}
+
+
+void KnowledgeState::snapshot(OUT knowledge_state_t& snapshot) const
+{
+  memcpy(&snapshot, &state, sizeof(knowledge_state_t));
+  return;
+}
+
+
+void KnowledgeState::restore(IN knowledge_state_t& snapshot)
+{
+  memcpy(&state, &snapshot, sizeof(knowledge_state_t));
+  return;
+}
+
+
+// ============================================================================
+// STATIC FUNCTION DEFINITIONS
+// ============================================================================
+
+
+static uint8_t count_letter_in_word(IN Word& word, IN char letter)
+{
+  uint8_t count = 0;
+
+  for (uint8_t index = 0; index < WORD_LENGTH; index++)
+  {
+    if (word[index] == letter)
+      count++;
+  }
+
+  return count;
+}
+
+
+static bool is_first_occurrence(IN Word& word, IN uint8_t index)
+{
+  for (uint8_t other_index = 0; other_index < index; other_index++)
+  {
+    if (word[other_index] == word[index])
+      return false;
+  }
+
+  return true;
+}
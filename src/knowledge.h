@@ -0,0 +1,73 @@
+#ifndef KNOWLEDGE_H
+#define KNOWLEDGE_H
+
+
+#include <stdint.h>
+
+#include "typehints.h"
+#include "word.h"
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+// Everything the guesses so far have revealed about the target. The struct
+// holds no pointers, so a snapshot is a plain copy and can be written to an
+// appvar as-is.
+typedef struct
+{
+  // Lower and upper bounds on how many times each letter is in the target.
+  uint8_t min_counts[ALPHABET_LENGTH];
+  uint8_t max_counts[ALPHABET_LENGTH];
+
+  // Bit `n` is set if the letter may still be at position `n`.
+  uint8_t allowed_positions[ALPHABET_LENGTH];
+
+  // The letter known to be at each position, or '\0'.
+  char solved_letters[WORD_LENGTH];
+
+  // Bit `n` is set if letter 'A' + n has been placed somewhere.
+  uint32_t placed_letters;
+
+  // Sum of min_counts, so that consistency checks need not visit every
+  // letter of the alphabet.
+  uint8_t total_min_count;
+} knowledge_state_t;
+
+
+// ============================================================================
+// CLASS DECLARATIONS
+// ============================================================================
+
+
+class KnowledgeState
+{
+  public:
+    enum letter_status_t : uint8_t
+    {
+      UNKNOWN = 0,
+      ABSENT,
+      PRESENT,
+      PLACED
+    };
+
+    KnowledgeState();
+
+    void reset();
+    void include_guess(IN Word& guess, IN word_evaluation_t evaluation);
+
+    bool satisfies_hard_mode(IN Word& guess) const;
+    bool is_consistent(IN Word& word) const;
+    letter_status_t get_letter_status(IN char letter) const;
+
+    void snapshot(OUT knowledge_state_t& snapshot) const;
+    void restore(IN knowledge_state_t& snapshot);
+
+  private:
+    knowledge_state_t state;
+};
+
+
+#endif
@@ -0,0 +1,339 @@
+#include <assert.h>
+#include <fileioc.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ladder.h"
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+#define MAX_NUM_WORDS (4096)
+#define NO_WORD       (0xFFFF)
+
+// The search buffers are far too large for the stack. Only one graph appvar
+// exists, so every LadderGraph shares them. They take about 24 KB for a full
+// dictionary, so they are only allocated while Ladder is being played.
+static uint16_t* list_offsets = NULL;
+static uint8_t* visited = NULL;
+static uint16_t* queue = NULL;
+static uint16_t* parents = NULL;
+static uint16_t level_ends[MAX_LADDER_LENGTH];
+
+
+// ============================================================================
+// STATIC FUNCTION DECLARATIONS
+// ============================================================================
+
+
+static uint16_t read_varint(IN uint8_t* bytes, MOD uint16_t& offset);
+static bool is_visited(IN uint16_t word_index);
+static void mark_visited(IN uint16_t word_index);
+
+
+// ============================================================================
+// CLASS LadderGraph FUNCTION DEFINITIONS
+// ============================================================================
+
+
+LadderGraph::LadderGraph()
+{
+  ti_var_t slot;
+  uint8_t version = 0;
+
+  this->graph_loaded = false;
+  this->num_words = 0;
+
+  if ((slot = ti_Open(LADDER_GRAPH_APPVAR, "r")))
+  {
+    ti_Read(&version, sizeof version, 1, slot);
+    ti_Read(&num_words, sizeof num_words, 1, slot);
+    this->neighbour_counts = (uint8_t*)ti_GetDataPtr(slot);
+    this->neighbour_lists = this->neighbour_counts + this->num_words;
+    ti_Close(slot);
+
+    if (version == VERSION && this->num_words <= MAX_NUM_WORDS)
+      this->graph_loaded = true;
+  }
+
+  return;
+}
+
+
+// Must be called before any search or neighbour lookup. Returns false, with
+// nothing allocated, if there is not enough memory.
+bool LadderGraph::allocate_search_buffers()
+{
+  assert(this->graph_loaded);
+
+  uint16_t offset = 0;
+
+  list_offsets = (uint16_t*)malloc(this->num_words * sizeof(uint16_t));
+  visited = (uint8_t*)malloc((this->num_words + 7) / 8);
+  queue = (uint16_t*)malloc(this->num_words * sizeof(uint16_t));
+  parents = (uint16_t*)malloc(this->num_words * sizeof(uint16_t));
+
+  if (
+    list_offsets == NULL || visited == NULL || queue == NULL
+    || parents == NULL
+  )
+  {
+    free_search_buffers();
+    return false;
+  }
+
+  // Lists are variable-length, so each list's start is found once here. A
+  // list ends after its last byte without the high bit set.
+  for (uint24_t index = 0; index < this->num_words; index++)
+  {
+    list_offsets[index] = offset;
+
+    for (uint8_t count = 0; count < neighbour_counts[index]; count++)
+      read_varint(this->neighbour_lists, offset);
+  }
+
+  return true;
+}
+
+
+void LadderGraph::free_search_buffers()
+{
+  free(list_offsets);
+  free(visited);
+  free(queue);
+  free(parents);
+  list_offsets = NULL;
+  visited = NULL;
+  queue = NULL;
+  parents = NULL;
+  return;
+}
+
+
+bool LadderGraph::is_loaded() const
+{
+  return this->graph_loaded;
+}
+
+
+uint24_t LadderGraph::get_num_words() const
+{
+  return this->num_words;
+}
+
+
+// Returns the number of neighbours. They are decoded in ascending order.
+uint8_t LadderGraph::get_neighbours(
+  IN uint16_t word_index, OUT uint16_t neighbours[MAX_NUM_NEIGHBOURS]
+) const
+{
+  assert(this->graph_loaded);
+  assert(list_offsets != NULL);
+  assert(word_index < this->num_words);
+
+  const uint8_t NUM_NEIGHBOURS = this->neighbour_counts[word_index];
+
+  uint16_t offset = list_offsets[word_index];
+  uint16_t value;
+
+  for (uint8_t index = 0; index < NUM_NEIGHBOURS; index++)
+  {
+    value = read_varint(this->neighbour_lists, offset);
+
+    // The first entry is the zigzag-coded offset from the word itself; the
+    // rest are gaps from the previous neighbour.
+    if (index == 0)
+    {
+      if (value & 1)
+        neighbours[0] = word_index - ((value + 1) >> 1);
+      else
+        neighbours[0] = word_index + (value >> 1);
+    }
+    else
+    {
+      neighbours[index] = neighbours[index - 1] + value + 1;
+    }
+  }
+
+  return NUM_NEIGHBOURS;
+}
+
+
+// Picks a random start word, a random distance between `min_distance` and
+// `max_distance` that some word is from it, and a random end word at exactly
+// that distance. Returns false if no start word tried had a word at least
+// `min_distance` steps away.
+bool LadderGraph::pick_random_pair(
+  IN uint8_t min_distance,
+  IN uint8_t max_distance,
+  OUT uint16_t& start,
+  OUT uint16_t& end,
+  OUT uint8_t& distance
+) const
+{
+  assert(this->graph_loaded);
+  assert(min_distance > 0 && max_distance < MAX_LADDER_LENGTH);
+
+  const uint8_t MAX_NUM_ATTEMPTS = 32;
+
+  uint16_t level_start;
+  uint8_t farthest_distance;
+
+  for (uint8_t attempt = 0; attempt < MAX_NUM_ATTEMPTS; attempt++)
+  {
+    start = rand() % this->num_words;
+
+    if (this->neighbour_counts[start] == 0)
+      continue;
+
+    farthest_distance = search(start, NO_WORD, max_distance);
+
+    if (farthest_distance < min_distance)
+      continue;
+
+    distance = (
+      min_distance + (rand() % (farthest_distance - min_distance + 1))
+    );
+    level_start = level_ends[distance - 1];
+    end = queue[level_start + (rand() % (level_ends[distance] - level_start))];
+    return true;
+  }
+
+  return false;
+}
+
+
+// Writes the words of one shortest ladder from `start` to `end`, both
+// included, into `path`. Returns the number of words written, or 0 if no
+// ladder of at most MAX_LADDER_LENGTH words exists.
+uint8_t LadderGraph::get_shortest_path(
+  IN uint16_t start, IN uint16_t end, OUT uint16_t path[MAX_LADDER_LENGTH]
+) const
+{
+  assert(this->graph_loaded);
+
+  uint8_t distance;
+  uint16_t current = end;
+
+  if (start == end)
+  {
+    path[0] = start;
+    return 1;
+  }
+
+  distance = search(start, end, MAX_LADDER_LENGTH - 1);
+
+  if (distance == 0)
+    return 0;
+
+  for (uint8_t index = distance + 1; index > 0; index--)
+  {
+    path[index - 1] = current;
+    current = parents[current];
+  }
+
+  return distance + 1;
+}
+
+
+// Breadth-first search from `start`, one distance level at a time. Words at
+// distance `d` end up in `queue` between level_ends[d - 1] and level_ends[d],
+// and `parents` links each word back towards `start`.
+//
+// If `end` is a word, returns its distance from `start`, or 0 if it is more
+// than `max_distance` steps away. If `end` is NO_WORD, returns the largest
+// distance at which any word was found.
+uint8_t LadderGraph::search(
+  IN uint16_t start, IN uint16_t end, IN uint8_t max_distance
+) const
+{
+  uint16_t neighbours[MAX_NUM_NEIGHBOURS];
+  uint8_t num_neighbours;
+  uint16_t head = 0;
+  uint16_t tail = 1;
+  uint16_t level_end;
+  uint16_t current;
+  uint8_t level = 0;
+
+  memset(visited, 0, (this->num_words + 7) / 8);
+  mark_visited(start);
+  queue[0] = start;
+  parents[start] = start;
+  level_ends[0] = 1;
+
+  while (level < max_distance)
+  {
+    level_end = tail;
+
+    while (head < level_end)
+    {
+      current = queue[head];
+      head++;
+      num_neighbours = get_neighbours(current, neighbours);
+
+      for (uint8_t index = 0; index < num_neighbours; index++)
+      {
+        if (is_visited(neighbours[index]))
+          continue;
+
+        mark_visited(neighbours[index]);
+        parents[neighbours[index]] = current;
+        queue[tail] = neighbours[index];
+        tail++;
+
+        if (neighbours[index] == end)
+          return level + 1;
+      }
+    }
+
+    if (tail == level_end)
+      break;
+
+    level++;
+    level_ends[level] = tail;
+  }
+
+  if (end != NO_WORD)
+    return 0;
+
+  return level;
+}
+
+
+// ============================================================================
+// STATIC FUNCTION DEFINITIONS
+// ============================================================================
+
+
+// Decodes the variable-length integer at `offset` and moves `offset` past it.
+static uint16_t read_varint(IN uint8_t* bytes, MOD uint16_t& offset)
+{
+  uint16_t value = 0;
+  uint8_t shift = 0;
+  uint8_t byte;
+
+  do {
+    byte = bytes[offset];
+    offset++;
+    value |= (uint16_t)(byte & 0x7F) << shift;
+    shift += 7;
+  } while (byte & 0x80);
+
+  return value;
+}
+
+
+static bool is_visited(IN uint16_t word_index)
+{
+  return visited[word_index >> 3] & (1 << (word_index & 7));
+}
+
+
+static void mark_visited(IN uint16_t word_index)
+{
+  visited[word_index >> 3] |= (1 << (word_index & 7));
+  return;
+}
@@ -0,0 +1,67 @@
+#ifndef LADDER_H
+#define LADDER_H
+
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "typehints.h"
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+#define LADDER_GRAPH_APPVAR ("GIMME5L")
+
+// A word has at most 25 neighbours in each of its five positions.
+#define MAX_NUM_NEIGHBOURS (125)
+#define MAX_LADDER_LENGTH  (16)
+
+
+// ============================================================================
+// CLASS DECLARATIONS
+// ============================================================================
+
+
+// Reads the one-letter-neighbour graph that `tools/ladder` builds for the
+// dictionary. Words are identified by their dictionary index.
+class LadderGraph
+{
+  public:
+    LadderGraph();
+
+    bool is_loaded() const;
+    bool allocate_search_buffers();
+    void free_search_buffers();
+    uint24_t get_num_words() const;
+    uint8_t get_neighbours(
+      IN uint16_t word_index, OUT uint16_t neighbours[MAX_NUM_NEIGHBOURS]
+    ) const;
+    bool pick_random_pair(
+      IN uint8_t min_distance,
+      IN uint8_t max_distance,
+      OUT uint16_t& start,
+      OUT uint16_t& end,
+      OUT uint8_t& distance
+    ) const;
+    uint8_t get_shortest_path(
+      IN uint16_t start, IN uint16_t end, OUT uint16_t path[MAX_LADDER_LENGTH]
+    ) const;
+
+  private:
+    static const uint8_t VERSION = 1;
+
+    bool graph_loaded;
+    uint24_t num_words;
+    uint8_t* neighbour_counts;
+    uint8_t* neighbour_lists;
+
+    uint8_t search(
+      IN uint16_t start, IN uint16_t end, IN uint8_t max_distance
+    ) const;
+};
+
+
+#endif
@@ -1,16 +1,72 @@
 #include <sys/lcd.h>
 #include <ti/screen.h>
 #include <graphx.h>
+#include <string.h>
 #include <time.h>
 
 #include "gfx/gfx.h"
 #include "dictionary.h"
+#include "framescheduler.h"
+#include "gameplay_adversarial.h"
 #include "gameplay_anagram.h"
+#include "gameplay_ladder.h"
 #include "gameplay_original.h"
+#include "gameplay_quad.h"
 #include "gameplay_rush.h"
 #include "gui.h"
 #include "ingamehelp.h"
 #include "keypad.h"
+#include "settings.h"
+#include "systemclock.h"
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+typedef struct
+{
+  Settings::SETTING_FLAG setting_flag;
+  const char* name;
+  const char* description[2];
+} setting_option_t;
+
+#define NUM_SETTING_OPTIONS (2)
+
+static const setting_option_t SETTING_OPTIONS[NUM_SETTING_OPTIONS] = {
+  {
+    .setting_flag = Settings::HARD_MODE,
+    .name = "Hard Mode",
+    .description = {
+      "Every guess must reuse all GREEN letters",
+      "in place and include all ORANGE letters."
+    }
+  },
+  {
+    .setting_flag = Settings::SKIP_TRANSITIONS,
+    .name = "Skip Transitions",
+    .description = {
+      "Show each new screen at once instead",
+      "of wiping it in from the bottom."
+    }
+  }
+};
+
+
+// The gameplay menu shows three options at a time and scrolls when the
+// selection moves past either edge. Icons are drawn at double size, offset from
+// the top center of their option.
+typedef struct
+{
+  const char* title;
+  gfx_sprite_t* icon;
+  uint8_t icon_xoffset;
+  uint8_t icon_yoffset;
+} gameplay_option_t;
+
+#define NUM_GAMEPLAY_OPTIONS (6)
+#define NUM_VISIBLE_GAMEPLAY_OPTIONS (3)
 
 
 // ============================================================================
@@ -22,12 +78,11 @@ static bool ensure_dictionary_is_accessible();
 static int main_menu();
 static void show_main_menu_help();
 static void word_code_entry_menu();
-static void draw_word_code_entry_menu(
-  IN char* user_input, MOD bool& full_redraw
-);
-static void invalid_code_notification();
 static void show_word_code_entry_menu_help();
 static void gameplay_menu();
+static void settings_menu();
+static void apply_transition_setting();
+static void draw_settings_menu(IN uint8_t option_index);
 
 
 // ============================================================================
@@ -44,11 +99,14 @@ int main(void)
 
   srand(time(NULL));
 
+  SystemClock::start();
+  apply_transition_setting();
   gui_StartGraphics();
   gui_DrawCheckeredBackground();
   gfx_BlitBuffer();
   exit_code = main_menu();
   gui_EndGraphics();
+  SystemClock::stop();
 
   return exit_code;
 }
@@ -105,19 +163,41 @@ static bool ensure_dictionary_is_accessible()
 
 static int main_menu()
 {
-  const uint8_t NUM_OPTIONS = 2;
-  const char* BUTTON_TITLES[] = { "Play Game", "Enter Code" };
-
+  const uint8_t NUM_OPTIONS = 3;
+  const char* BUTTON_TITLES[] = { "Play Game", "Enter Code", "Settings" };
+
+  ScreenWidget screen;
+  SpriteWidget logo(
+    spr_logo, (LCD_WIDTH / 2) - (1.5 * spr_logo->width), 5, 3, 2
+  );
+  SpriteWidget all_stars_logo(
+    spr_all_stars_logo, (LCD_WIDTH / 2) - spr_all_stars_logo->width, 94, 2, 1
+  );
+  ButtonWidget buttons[NUM_OPTIONS];
   uint8_t option_index = 0;
-  uint8_t button_ypos;
   bool full_redraw = true;
 
+  screen.add_child(logo);
+  screen.add_child(all_stars_logo);
+
+  for (uint8_t index = 0; index < NUM_OPTIONS; index++)
+  {
+    buttons[index].set_title(BUTTON_TITLES[index]);
+    buttons[index].set_ypos(126 + (index * 33));
+    screen.add_child(buttons[index]);
+  }
+
   if (InGameHelp::must_show_help_for(InGameHelp::MAIN_MENU))
     show_main_menu_help();
 
   while (true)
   {
-    Keypad::update_state();
+    FrameScheduler::start_frame();
+
+    // Nothing on the menu screens changes without a key press, so frames with
+    // no keys down are skipped.
+    if (!full_redraw && Keypad::is_idle())
+      continue;
 
     if (Keypad::is_down_repeating(kb_KeyUp))
     {
@@ -159,38 +239,25 @@ static int main_menu()
         word_code_entry_menu();
         full_redraw = true;
       }
+      else if (option_index == 2)
+      {
+        settings_menu();
+        full_redraw = true;
+      }
       else
       {
         break;
       }
     }
 
-    if (full_redraw)
-    {
-      gui_DrawCheckeredBackground();
-      gfx_ScaledTransparentSprite_NoClip(
-        spr_logo, (LCD_WIDTH / 2) - (1.5 * spr_logo->width), 5, 3, 2
-      );
-      gfx_ScaledTransparentSprite_NoClip(
-        spr_all_stars_logo,
-        (LCD_WIDTH / 2) - spr_all_stars_logo->width,
-        94,
-        2,
-        1
-      );
-    }
-
-    button_ypos = 145;
-
+    // Moving the selection redraws only the two buttons that changed.
     for (uint8_t index = 0; index < NUM_OPTIONS; index++)
-    {
-      if (option_index == index)
-        gui_DrawButtonSelected(BUTTON_TITLES[index], button_ypos);
-      else
-        gui_DrawButton(BUTTON_TITLES[index], button_ypos);
+      buttons[index].set_selected(index == option_index);
 
-      button_ypos += 35;
-    }
+    if (full_redraw)
+      screen.invalidate();
+
+    screen.render();
 
     if (full_redraw)
     {
@@ -199,7 +266,7 @@ static int main_menu()
     }
     else
     {
-      gfx_SwapDraw();
+      gui_BlitDirtyRegions();
     }
   }
 
@@ -246,7 +313,10 @@ static void show_main_menu_help()
 
   while (true)
   {
-    Keypad::update_state();
+    FrameScheduler::start_frame();
+
+    if (!transition_in && Keypad::is_idle())
+      continue;
 
     if (Keypad::is_down_repeating(kb_KeyLeft) && page_num > 1)
       page_num--;
@@ -288,6 +358,9 @@ static void show_main_menu_help()
 
 static void word_code_entry_menu()
 {
+  const uint8_t CONTAINER_YPOS = 96;
+  const uint8_t CONTAINER_HEIGHT = 75;
+
   OriginalGameplay original_gameplay;
   char input[20] = { '\0' };
   char letter;
@@ -296,6 +369,28 @@ static void word_code_entry_menu()
   bool transition_in = true;
   bool full_redraw = true;
 
+  ScreenWidget screen("Word Code Entry");
+  ContainerWidget container;
+  TextWidget first_line;
+  TextWidget second_line;
+  InputFieldWidget input_field(CONTAINER_YPOS + CONTAINER_HEIGHT - 27, 180);
+
+  container.set_ypos(CONTAINER_YPOS);
+  container.set_width(256);
+  container.set_height(CONTAINER_HEIGHT);
+  container.center_horizontally_on_screen();
+  first_line.set_string("Enter a word code into");
+  first_line.set_font(GuiText::NORMAL_SIZE_WITH_SHADOW);
+  first_line.set_ypos(CONTAINER_YPOS + 10);
+  second_line.set_string("the field below.");
+  second_line.set_font(GuiText::NORMAL_SIZE_WITH_SHADOW);
+  second_line.set_ypos(CONTAINER_YPOS + 21);
+  input_field.set_input(input);
+  screen.add_child(container);
+  container.add_child(first_line);
+  container.add_child(second_line);
+  container.add_child(input_field);
+
   gui_TransitionOut();
 
   if (InGameHelp::must_show_help_for(InGameHelp::WORD_CODE_ENTRY_MENU))
@@ -303,7 +398,13 @@ static void word_code_entry_menu()
 
   while (true)
   {
-    Keypad::update_state();
+    FrameScheduler::start_frame();
+
+    if (
+      !transition_in && !full_redraw && Keypad::is_idle()
+      && !gui_IsNotificationShowing()
+    )
+      continue;
 
     if (
       keypad_GetHexAsciiCharacter(letter)
@@ -312,11 +413,13 @@ static void word_code_entry_menu()
     {
       input[num_characters] = letter;
       num_characters++;
+      input_field.set_input(input);
     }
     else if (Keypad::is_down_repeating(kb_KeyDel) && num_characters > 0)
     {
       num_characters--;
       input[num_characters] = '\0';
+      input_field.set_input(input);
     }
     else if (
       Keypad::was_released_exclusive(kb_Key2nd)
@@ -326,12 +429,12 @@ static void word_code_entry_menu()
       if (original_gameplay.is_valid_code(input))
       {
         original_gameplay.play_valid_word_code(input);
+        Gameplay::free_tile_cache();
         break;
       }
       else
       {
-        invalid_code_notification();
-        full_redraw = true;
+        gui_QueueNotification("Invalid code!");
       }
     }
     else if (Keypad::was_released_exclusive(kb_KeyMode))
@@ -346,7 +449,14 @@ static void word_code_entry_menu()
       break;
     }
 
-    draw_word_code_entry_menu(input, full_redraw);
+    if (full_redraw)
+    {
+      screen.invalidate();
+      full_redraw = false;
+    }
+
+    // Typing redraws only the input field.
+    screen.render();
 
     if (transition_in)
     {
@@ -355,7 +465,7 @@ static void word_code_entry_menu()
     }
     else
     {
-      gfx_BlitBuffer();
+      gui_BlitDirtyRegions();
     }
   }
 
@@ -364,62 +474,6 @@ static void word_code_entry_menu()
 }
 
 
-static void draw_word_code_entry_menu(
-  IN char* user_input, MOD bool& full_redraw
-)
-{
-  const uint8_t CONTAINER_YPOS = 96;
-  const uint8_t CONTAINER_HEIGHT = 75;
-
-  GuiText text;
-  Container code_input_container;
-  InputField input_field(CONTAINER_YPOS + CONTAINER_HEIGHT - 27, 180);
-
-  code_input_container.set_ypos(CONTAINER_YPOS);
-  code_input_container.set_width(256);
-  code_input_container.set_height(CONTAINER_HEIGHT);
-  code_input_container.center_horizontally_on_screen();
-
-  if (full_redraw)
-  {
-    gui_DrawCheckeredBackground();
-    gui_DrawMenuTitle("Word Code Entry");
-    code_input_container.draw();
-
-    text.set_font(GuiText::NORMAL_SIZE_WITH_SHADOW);
-    text.set_ypos(CONTAINER_YPOS + 10);
-    text.draw_centered_string("Enter a word code into");
-    text.set_ypos(CONTAINER_YPOS + 21);
-    text.draw_centered_string("the field below.");
-
-    full_redraw = false;
-  }
-
-  input_field.draw_input(user_input);
-  return;
-}
-
-
-static void invalid_code_notification()
-{
-  Notification notification("Invalid code!");
-
-  notification.draw();
-
-  while (true)
-  {
-    Keypad::update_state();
-
-    if (Keypad::was_any_key_released())
-      break;
-
-    notification.blit();
-  }
-
-  return;
-}
-
-
 static void show_word_code_entry_menu_help()
 {
   const uint8_t NUM_STRINGS_ON_FIRST_PAGE = 11;
@@ -464,7 +518,10 @@ static void show_word_code_entry_menu_help()
 
   while (true)
   {
-    Keypad::update_state();
+    FrameScheduler::start_frame();
+
+    if (!transition_in && Keypad::is_idle())
+      continue;
 
     if (Keypad::is_down_repeating(kb_KeyLeft) && page_num > 1)
       page_num--;
@@ -510,17 +567,64 @@ static void show_word_code_entry_menu_help()
 
 static void gameplay_menu()
 {
-  const uint8_t NUM_OPTIONS = 3;
+  const gameplay_option_t OPTIONS[NUM_GAMEPLAY_OPTIONS] = {
+    {
+      .title = "Rush",
+      .icon = spr_gameplay_rush_icon,
+      .icon_xoffset = spr_gameplay_rush_icon->width,
+      .icon_yoffset = 32
+    },
+    {
+      .title = "Original",
+      .icon = spr_gameplay_original_icon,
+      .icon_xoffset = spr_gameplay_original_icon->width,
+      .icon_yoffset = 20
+    },
+    {
+      .title = "Anagram",
+      .icon = spr_gameplay_anagram_icon,
+      .icon_xoffset = (uint8_t)(spr_gameplay_anagram_icon->width - 1),
+      .icon_yoffset = 38
+    },
+    {
+      .title = "Absurd",
+      .icon = spr_gameplay_adversarial_icon,
+      .icon_xoffset = spr_gameplay_adversarial_icon->width,
+      .icon_yoffset = 36
+    },
+    {
+      .title = "Quad",
+      .icon = spr_gameplay_quad_icon,
+      .icon_xoffset = spr_gameplay_quad_icon->width,
+      .icon_yoffset = 36
+    },
+    {
+      .title = "Ladder",
+      .icon = spr_gameplay_ladder_icon,
+      .icon_xoffset = spr_gameplay_ladder_icon->width,
+      .icon_yoffset = 36
+    }
+  };
+  const uint24_t OPTION_XPOSITIONS[NUM_VISIBLE_GAMEPLAY_OPTIONS] = {
+    (LCD_WIDTH / 6) + 2, LCD_WIDTH / 2, ((LCD_WIDTH / 6) * 5) - 2
+  };
+  const uint8_t PAGE_ARROW_YPOS = 200;
 
   OriginalGameplay original_gameplay;
   RushGameplay rush_gameplay;
   AnagramGameplay anagram_gameplay;
-  Gameplay* gameplay_options[NUM_OPTIONS] = {
-    &rush_gameplay, &original_gameplay, &anagram_gameplay
+  AdversarialGameplay adversarial_gameplay;
+  QuadGameplay quad_gameplay;
+  LadderGameplay ladder_gameplay;
+  Gameplay* gameplay_options[NUM_GAMEPLAY_OPTIONS] = {
+    &rush_gameplay, &original_gameplay, &anagram_gameplay,
+    &adversarial_gameplay, &quad_gameplay, &ladder_gameplay
   };
   GuiText text;
 
   uint8_t option_index = 1;
+  uint8_t first_visible_index;
+  uint8_t visible_index;
   bool transition_in = true;
   bool draw_help = false;
   point_t origin;
@@ -529,7 +633,10 @@ static void gameplay_menu()
 
   while (true)
   {
-    Keypad::update_state();
+    FrameScheduler::start_frame();
+
+    if (!transition_in && Keypad::is_idle())
+      continue;
 
     if (Keypad::was_released_exclusive(kb_KeyMode))
     {
@@ -544,13 +651,13 @@ static void gameplay_menu()
       if (option_index > 0)
         option_index--;
       else
-        option_index = NUM_OPTIONS - 1;
+        option_index = NUM_GAMEPLAY_OPTIONS - 1;
 
       draw_help = false;
     }
     else if (Keypad::is_down_repeating(kb_KeyRight))
     {
-      if (option_index + 1 < NUM_OPTIONS)
+      if (option_index + 1 < NUM_GAMEPLAY_OPTIONS)
         option_index++;
       else
         option_index = 0;
@@ -563,68 +670,63 @@ static void gameplay_menu()
     )
     {
       gameplay_options[option_index]->play_random_word();
+      Gameplay::free_tile_cache();
       transition_in = true;
     }
 
+    // Keep the selected option in the middle slot except at either end.
+    if (option_index == 0)
+      first_visible_index = 0;
+    else if (
+      option_index + NUM_VISIBLE_GAMEPLAY_OPTIONS - 1 > NUM_GAMEPLAY_OPTIONS
+    )
+      first_visible_index = NUM_GAMEPLAY_OPTIONS - NUM_VISIBLE_GAMEPLAY_OPTIONS;
+    else
+      first_visible_index = option_index - 1;
+
     gui_DrawCheckeredBackground();
     gui_DrawMenuTitle("Gameplay");
 
-    origin.xpos = (LCD_WIDTH / 6) + 2;
-    origin.ypos = 72;
-
-    if (option_index == 0)
+    for (uint8_t slot = 0; slot < NUM_VISIBLE_GAMEPLAY_OPTIONS; slot++)
     {
-      origin.ypos = 66;
-      gui_DrawGameplayOptionSelected("Rush", origin);
-    }
-    else
-      gui_DrawGameplayOption("Rush", origin);
-
-    gfx_ScaledTransparentSprite_NoClip(
-      spr_gameplay_rush_icon,
-      origin.xpos - spr_gameplay_rush_icon->width,
-      origin.ypos + 32,
-      2,
-      2
-    );
+      visible_index = first_visible_index + slot;
+      origin.xpos = OPTION_XPOSITIONS[slot];
+      origin.ypos = 72;
 
-    origin.xpos = LCD_WIDTH / 2;
-    origin.ypos = 72;
+      if (option_index == visible_index)
+      {
+        origin.ypos = 66;
+        gui_DrawGameplayOptionSelected(OPTIONS[visible_index].title, origin);
+      }
+      else
+        gui_DrawGameplayOption(OPTIONS[visible_index].title, origin);
 
-    if (option_index == 1)
-    {
-      origin.ypos = 66;
-      gui_DrawGameplayOptionSelected("Original", origin);
+      gfx_ScaledTransparentSprite_NoClip(
+        OPTIONS[visible_index].icon,
+        origin.xpos - OPTIONS[visible_index].icon_xoffset,
+        origin.ypos + OPTIONS[visible_index].icon_yoffset,
+        2,
+        2
+      );
     }
-    else
-      gui_DrawGameplayOption("Original", origin);
-
-    gfx_ScaledTransparentSprite_NoClip(
-      spr_gameplay_original_icon,
-      origin.xpos - spr_gameplay_original_icon->width,
-      origin.ypos + 20,
-      2,
-      2
-    );
 
-    origin.xpos = ((LCD_WIDTH / 6) * 5) - 2;
-    origin.ypos = 72;
+    if (first_visible_index > 0)
+    {
+      gfx_TransparentSprite_NoClip(
+        spr_page_arrow_left, 12, PAGE_ARROW_YPOS
+      );
+    }
 
-    if (option_index == 2)
+    if (
+      first_visible_index + NUM_VISIBLE_GAMEPLAY_OPTIONS < NUM_GAMEPLAY_OPTIONS
+    )
     {
-      origin.ypos = 66;
-      gui_DrawGameplayOptionSelected("Anagram", origin);
+      gfx_TransparentSprite_NoClip(
+        spr_page_arrow_right,
+        LCD_WIDTH - spr_page_arrow_right->width - 12,
+        PAGE_ARROW_YPOS
+      );
     }
-    else
-      gui_DrawGameplayOption("Anagram", origin);
-
-    gfx_ScaledTransparentSprite_NoClip(
-      spr_gameplay_anagram_icon,
-      origin.xpos - spr_gameplay_anagram_icon->width + 1,
-      origin.ypos + 38,
-      2,
-      2
-    );
 
     if (draw_help)
     {
@@ -645,3 +747,111 @@ static void gameplay_menu()
   gui_TransitionOut();
   return;
 }
+
+
+static void settings_menu()
+{
+  uint8_t option_index = 0;
+  bool transition_in = true;
+
+  gui_TransitionOut();
+
+  while (true)
+  {
+    FrameScheduler::start_frame();
+
+    if (!transition_in && Keypad::is_idle())
+      continue;
+
+    if (Keypad::is_down_repeating(kb_KeyUp))
+    {
+      if (option_index > 0)
+        option_index--;
+      else
+        option_index = NUM_SETTING_OPTIONS - 1;
+    }
+    else if (Keypad::is_down_repeating(kb_KeyDown))
+    {
+      if (option_index + 1 < NUM_SETTING_OPTIONS)
+        option_index++;
+      else
+        option_index = 0;
+    }
+    else if (
+      Keypad::was_released_exclusive(kb_Key2nd)
+      || Keypad::was_released_exclusive(kb_KeyEnter)
+    )
+    {
+      Settings::toggle(SETTING_OPTIONS[option_index].setting_flag);
+      apply_transition_setting();
+    }
+    else if (Keypad::was_released_exclusive(kb_KeyClear))
+    {
+      break;
+    }
+
+    draw_settings_menu(option_index);
+
+    if (transition_in)
+    {
+      gui_TransitionIn();
+      transition_in = false;
+    }
+    else
+    {
+      gfx_BlitBuffer();
+    }
+  }
+
+  gui_TransitionOut();
+  return;
+}
+
+
+static void apply_transition_setting()
+{
+  gui_SetTransitionDuration(
+    Settings::is_enabled(Settings::SKIP_TRANSITIONS)
+    ? 0
+    : DEFAULT_TRANSITION_DURATION
+  );
+  return;
+}
+
+
+static void draw_settings_menu(IN uint8_t option_index)
+{
+  const uint8_t MAX_TITLE_LENGTH = 20;
+
+  GuiText text;
+  char title[MAX_TITLE_LENGTH + 1];
+  uint8_t button_ypos = 72;
+
+  gui_DrawCheckeredBackground();
+  gui_DrawMenuTitle("Settings");
+
+  for (uint8_t index = 0; index < NUM_SETTING_OPTIONS; index++)
+  {
+    strcpy(title, SETTING_OPTIONS[index].name);
+    strcat(
+      title,
+      Settings::is_enabled(SETTING_OPTIONS[index].setting_flag)
+      ? ": On"
+      : ": Off"
+    );
+
+    if (option_index == index)
+      gui_DrawButtonSelected(title, button_ypos);
+    else
+      gui_DrawButton(title, button_ypos);
+
+    button_ypos += 35;
+  }
+
+  text.set_font(GuiText::NORMAL_SIZE_WITH_SHADOW);
+  text.set_ypos(LCD_HEIGHT - (2 * GFX_DEFAULT_FONT_HEIGHT) - 20);
+  text.draw_centered_string(SETTING_OPTIONS[option_index].description[0]);
+  text.set_ypos(LCD_HEIGHT - GFX_DEFAULT_FONT_HEIGHT - 16);
+  text.draw_centered_string(SETTING_OPTIONS[option_index].description[1]);
+  return;
+}
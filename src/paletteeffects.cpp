@@ -0,0 +1,206 @@
+#include <graphx.h>
+
+#include "gfx/gfx.h"
+#include "framescheduler.h"
+#include "paletteeffects.h"
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+#define NUM_PALETTE_ENTRIES (sizeof_global_palette / 2)
+
+// Palette entries are 1555 colors. The top bit is dropped from blended colors,
+// which leaves them one step darker in green at most.
+#define RED_SHIFT      (10)
+#define GREEN_SHIFT    (5)
+#define COMPONENT_MASK (0x1f)
+#define WHITE_1555     (0x7fff)
+#define BLACK_1555     (0x0000)
+
+
+// ============================================================================
+// STATIC FUNCTION DECLARATIONS
+// ============================================================================
+
+
+static uint16_t get_loaded_color(IN uint8_t index);
+static uint16_t blend_colors(
+  IN uint16_t color, IN uint16_t target_color, IN uint8_t level
+);
+static uint8_t get_triangle_wave_level(
+  IN ticks_t elapsed_time, IN ticks_t period
+);
+
+
+// ============================================================================
+// CLASS PaletteEffects FUNCTION DEFINITIONS
+// ============================================================================
+
+
+void PaletteEffects::restore()
+{
+  gfx_SetPalette(global_palette, sizeof_global_palette, 0);
+  return;
+}
+
+
+// Sets every entry to the given level between black and its loaded color.
+void PaletteEffects::dim(IN uint8_t level)
+{
+  if (level >= PALETTE_FULL_LEVEL)
+  {
+    restore();
+    return;
+  }
+
+  for (uint8_t index = 0; index < NUM_PALETTE_ENTRIES; index++)
+  {
+    gfx_palette[index] = blend_colors(
+      get_loaded_color(index), BLACK_1555, level
+    );
+  }
+
+  return;
+}
+
+
+void PaletteEffects::fade(
+  IN uint8_t from_level, IN uint8_t to_level, IN ticks_t duration
+)
+{
+  const ticks_t START_TIMESTAMP = SystemClock::now();
+
+  ticks_t elapsed_time = 0;
+  int24_t level;
+
+  while (elapsed_time < duration)
+  {
+    level = from_level + (int24_t)(
+      ((int24_t)to_level - from_level) * (int24_t)elapsed_time
+      / (int24_t)duration
+    );
+    dim((uint8_t)level);
+
+    FrameScheduler::wait_for_next_frame();
+    elapsed_time = SystemClock::now() - START_TIMESTAMP;
+  }
+
+  dim(to_level);
+  return;
+}
+
+
+// Brightens the color halfway to white and back, num_flashes times.
+void PaletteEffects::flash(
+  IN uint8_t color, IN uint8_t num_flashes, IN ticks_t duration
+)
+{
+  const ticks_t START_TIMESTAMP = SystemClock::now();
+  const ticks_t PERIOD = duration / num_flashes;
+  const uint16_t LOADED_COLOR = get_loaded_color(color);
+
+  ticks_t elapsed_time = 0;
+
+  while (elapsed_time < duration)
+  {
+    gfx_palette[color] = blend_colors(
+      LOADED_COLOR,
+      WHITE_1555,
+      PALETTE_FULL_LEVEL
+      - (get_triangle_wave_level(elapsed_time, PERIOD) / 2)
+    );
+
+    FrameScheduler::wait_for_next_frame();
+    elapsed_time = SystemClock::now() - START_TIMESTAMP;
+  }
+
+  gfx_palette[color] = LOADED_COLOR;
+  return;
+}
+
+
+// Darkens the color to half and back, num_pulses times.
+void PaletteEffects::pulse(
+  IN uint8_t color, IN uint8_t num_pulses, IN ticks_t duration
+)
+{
+  const ticks_t START_TIMESTAMP = SystemClock::now();
+  const ticks_t PERIOD = duration / num_pulses;
+  const uint16_t LOADED_COLOR = get_loaded_color(color);
+
+  ticks_t elapsed_time = 0;
+
+  while (elapsed_time < duration)
+  {
+    gfx_palette[color] = blend_colors(
+      LOADED_COLOR,
+      BLACK_1555,
+      PALETTE_FULL_LEVEL
+      - (get_triangle_wave_level(elapsed_time, PERIOD) / 2)
+    );
+
+    FrameScheduler::wait_for_next_frame();
+    elapsed_time = SystemClock::now() - START_TIMESTAMP;
+  }
+
+  gfx_palette[color] = LOADED_COLOR;
+  return;
+}
+
+
+// ============================================================================
+// STATIC FUNCTION DEFINITIONS
+// ============================================================================
+
+
+static uint16_t get_loaded_color(IN uint8_t index)
+{
+  return (
+    global_palette[2 * index] | (global_palette[(2 * index) + 1] << 8)
+  );
+}
+
+
+// The result is target_color at level 0 and color at PALETTE_FULL_LEVEL.
+static uint16_t blend_colors(
+  IN uint16_t color, IN uint16_t target_color, IN uint8_t level
+)
+{
+  uint16_t result = 0;
+  int24_t component;
+  int24_t target_component;
+
+  for (uint8_t shift = 0; shift <= RED_SHIFT; shift += GREEN_SHIFT)
+  {
+    component = (color >> shift) & COMPONENT_MASK;
+    target_component = (target_color >> shift) & COMPONENT_MASK;
+    component = target_component + (
+      ((component - target_component) * level) / PALETTE_FULL_LEVEL
+    );
+    result |= (uint16_t)component << shift;
+  }
+
+  return result;
+}
+
+
+// Rises from 0 to PALETTE_FULL_LEVEL over the first half of each period and
+// falls back over the second half.
+static uint8_t get_triangle_wave_level(
+  IN ticks_t elapsed_time, IN ticks_t period
+)
+{
+  const ticks_t HALF_PERIOD = period / 2;
+  const ticks_t PHASE = elapsed_time % period;
+  const ticks_t DISTANCE_FROM_START = (
+    PHASE < HALF_PERIOD ? PHASE : period - PHASE
+  );
+
+  if (DISTANCE_FROM_START >= HALF_PERIOD)
+    return PALETTE_FULL_LEVEL;
+
+  return (DISTANCE_FROM_START * PALETTE_FULL_LEVEL) / HALF_PERIOD;
+}
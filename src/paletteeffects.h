@@ -0,0 +1,51 @@
+#ifndef PALETTE_EFFECTS_H
+#define PALETTE_EFFECTS_H
+
+
+#include <stdint.h>
+
+#include "systemclock.h"
+#include "typehints.h"
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+// Levels run from 0, which is black, to PALETTE_FULL_LEVEL, which is the
+// palette as it was loaded.
+#define PALETTE_FULL_LEVEL (32)
+
+
+// ============================================================================
+// CLASS DECLARATIONS
+// ============================================================================
+
+
+// Effects that change how colors look by rewriting entries of the LCD palette
+// instead of drawing pixels. Every pixel of a color changes at once, for the
+// cost of a few palette writes per frame. The timed effects wait for frames
+// with FrameScheduler but do not read the keypad, and they leave the palette
+// as it was loaded.
+class PaletteEffects
+{
+  public:
+    static void restore();
+    static void dim(IN uint8_t level);
+    static void fade(
+      IN uint8_t from_level, IN uint8_t to_level, IN ticks_t duration
+    );
+    static void flash(
+      IN uint8_t color, IN uint8_t num_flashes, IN ticks_t duration
+    );
+    static void pulse(
+      IN uint8_t color, IN uint8_t num_pulses, IN ticks_t duration
+    );
+
+  private:
+    PaletteEffects();
+};
+
+
+#endif
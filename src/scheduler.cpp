@@ -0,0 +1,96 @@
+#include <assert.h>
+#include <stddef.h>
+
+#include "scheduler.h"
+
+
+// ============================================================================
+// CLASS Scheduler FUNCTION DEFINITIONS
+// ============================================================================
+
+
+Scheduler::Scheduler()
+{
+  clear();
+  return;
+}
+
+
+// Adding a task that is already scheduled does nothing. Returns false if there
+// is no room for the task.
+bool Scheduler::add(Task* task)
+{
+  assert(task != NULL);
+
+  for (uint8_t index = 0; index < num_tasks; index++)
+  {
+    if (tasks[index] == task)
+      return true;
+  }
+
+  if (num_tasks == MAX_NUM_TASKS)
+    return false;
+
+  tasks[num_tasks] = task;
+  num_tasks++;
+  return true;
+}
+
+
+void Scheduler::remove(Task* task)
+{
+  for (uint8_t index = 0; index < num_tasks; index++)
+  {
+    if (tasks[index] == task)
+    {
+      num_tasks--;
+      tasks[index] = tasks[num_tasks];
+
+      if (next_index >= num_tasks)
+        next_index = 0;
+
+      return;
+    }
+  }
+
+  return;
+}
+
+
+void Scheduler::clear()
+{
+  num_tasks = 0;
+  next_index = 0;
+  return;
+}
+
+
+bool Scheduler::is_idle() const
+{
+  return num_tasks == 0;
+}
+
+
+// Steps the tasks in turn, at least once, until the budget is used up or every
+// task has finished. Finished tasks are taken off the scheduler.
+void Scheduler::run(IN ticks_t time_budget)
+{
+  const ticks_t DEADLINE = SystemClock::now() + time_budget;
+
+  Task* task;
+
+  while (num_tasks > 0)
+  {
+    task = tasks[next_index];
+
+    if (task->step())
+      remove(task);
+    else
+      next_index = (next_index + 1) % num_tasks;
+
+    if (SystemClock::has_passed(DEADLINE))
+      break;
+  }
+
+  return;
+}
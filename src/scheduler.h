@@ -0,0 +1,64 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "systemclock.h"
+#include "typehints.h"
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+// How long the gameplay loops let their tasks run on a frame with nothing to
+// redraw. Short enough that the next Keypad::update_state() is not delayed
+// noticeably.
+#define SCHEDULER_IDLE_FRAME_BUDGET (5 * TICKS_PER_MILLISECOND)
+
+
+// ============================================================================
+// CLASS DECLARATIONS
+// ============================================================================
+
+
+// A piece of work that is too slow to do in one frame. It is written as a
+// resumable state machine: every call to step() does a small, bounded slice
+// of the work and picks up where the last call left off.
+class Task
+{
+  public:
+    virtual ~Task() {}
+
+    // Returns true once the task has finished.
+    virtual bool step() = 0;
+};
+
+
+// Runs tasks cooperatively in turn until a time budget is used up. Tasks are
+// not owned by the scheduler and must outlive their time on it.
+class Scheduler
+{
+  public:
+    static const uint8_t MAX_NUM_TASKS = 4;
+
+    Scheduler();
+
+    bool add(Task* task);
+    void remove(Task* task);
+    void clear();
+
+    bool is_idle() const;
+    void run(IN ticks_t time_budget);
+
+  private:
+    Task* tasks[MAX_NUM_TASKS];
+    uint8_t num_tasks;
+    uint8_t next_index;
+};
+
+
+#endif
@@ -0,0 +1,115 @@
+#include <fileioc.h>
+
+#include "settings.h"
+
+
+#define SETTINGS_APPVAR ("GIMME5C")
+
+
+// ============================================================================
+// VERSION HISTORY FOR Settings CLASS
+// ============================================================================
+//
+// Version 0 (Release)
+//
+//    enum SETTING_FLAG : uint8_t
+//    {
+//      HARD_MODE = (1 << 0)
+//    };
+//
+//    SKIP_TRANSITIONS = (1 << 1) was added later without a new version. It is
+//    clear in older appvars, which leaves transitions on as they were.
+//
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+typedef struct
+{
+  uint8_t version;
+  uint8_t enabled_setting_flags;
+} appvar_data_t;
+
+
+// ============================================================================
+// CLASS Settings FUNCTION DEFINITIONS
+// ============================================================================
+
+
+Settings Settings::instance;
+uint8_t Settings::version;
+uint8_t Settings::enabled_setting_flags;
+
+
+bool Settings::is_enabled(IN SETTING_FLAG setting_flag)
+{
+  return (enabled_setting_flags & setting_flag);
+}
+
+
+void Settings::toggle(IN SETTING_FLAG setting_flag)
+{
+  enabled_setting_flags ^= setting_flag;
+  return;
+}
+
+
+Settings::Settings()
+{
+  if (!load_from_appvar())
+    load_defaults();
+
+  if (this->LATEST_VERSION != this->version)
+    load_defaults();
+
+  return;
+}
+
+
+Settings::~Settings()
+{
+  const appvar_data_t DATA = {
+    .version = this->version,
+    .enabled_setting_flags = this->enabled_setting_flags
+  };
+
+  ti_var_t slot;
+
+  if ((slot = ti_Open(SETTINGS_APPVAR, "w")))
+  {
+    ti_Write(&DATA, sizeof DATA, 1, slot);
+    ti_Close(slot);
+  }
+
+  return;
+}
+
+
+bool Settings::load_from_appvar()
+{
+  ti_var_t slot;
+  appvar_data_t data;
+
+  if ((slot = ti_Open(SETTINGS_APPVAR, "r")))
+  {
+    ti_Read(&data, sizeof data, 1, slot);
+    ti_Close(slot);
+
+    this->version = data.version;
+    this->enabled_setting_flags = data.enabled_setting_flags;
+    return true;
+  }
+
+  return false;
+}
+
+
+void Settings::load_defaults()
+{
+  this->version = this->LATEST_VERSION;
+  this->enabled_setting_flags = 0;
+  return;
+}
@@ -0,0 +1,41 @@
+#ifndef SETTINGS_H
+#define SETTINGS_H
+
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "typehints.h"
+
+
+// ============================================================================
+// CLASS DECLARATIONS
+// ============================================================================
+
+
+class Settings
+{
+  public:
+    enum SETTING_FLAG : uint8_t
+    {
+      HARD_MODE = (1 << 0),
+      SKIP_TRANSITIONS = (1 << 1)
+    };
+
+    static bool is_enabled(IN SETTING_FLAG setting_flag);
+    static void toggle(IN SETTING_FLAG setting_flag);
+
+  private:
+    const uint8_t LATEST_VERSION = 0;
+    static Settings instance;
+    static uint8_t version;
+    static uint8_t enabled_setting_flags;
+
+    Settings();
+    ~Settings();
+    bool load_from_appvar();
+    void load_defaults();
+};
+
+
+#endif
@@ -0,0 +1,52 @@
+#include <sys/timers.h>
+
+#include "systemclock.h"
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+#define CLOCK_TIMER (2)
+
+
+// ============================================================================
+// CLASS SystemClock FUNCTION DEFINITIONS
+// ============================================================================
+
+
+void SystemClock::start()
+{
+  timer_Disable(CLOCK_TIMER);
+  timer_Set(CLOCK_TIMER, 0);
+  timer_Enable(CLOCK_TIMER, TIMER_32K, TIMER_NOINT, TIMER_UP);
+  return;
+}
+
+
+void SystemClock::stop()
+{
+  timer_Disable(CLOCK_TIMER);
+  return;
+}
+
+
+ticks_t SystemClock::now()
+{
+  return timer_GetSafe(CLOCK_TIMER, TIMER_UP);
+}
+
+
+bool SystemClock::has_passed(IN ticks_t deadline)
+{
+  return has_reached(now(), deadline);
+}
+
+
+// Compares through the signed difference, so the answer stays right when the
+// count wraps around.
+bool SystemClock::has_reached(IN ticks_t timestamp, IN ticks_t deadline)
+{
+  return (int32_t)(timestamp - deadline) >= 0;
+}
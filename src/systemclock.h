@@ -0,0 +1,47 @@
+#ifndef SYSTEM_CLOCK_H
+#define SYSTEM_CLOCK_H
+
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "typehints.h"
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+// The clock counts the 32768 Hz crystal, so a tick is about 30 microseconds
+// and a 32-bit count lasts for more than a day and a half.
+#define TICKS_PER_SECOND      (32768UL)
+#define TICKS_PER_MILLISECOND (TICKS_PER_SECOND / 1000)
+
+typedef uint32_t ticks_t;
+
+
+// ============================================================================
+// CLASS DECLARATIONS
+// ============================================================================
+
+
+// A monotonic time source on hardware timer 2. Deadlines should be advanced by
+// adding a period to the old deadline rather than to the current time, so that
+// the time it takes to notice a deadline never adds up.
+class SystemClock
+{
+  public:
+    static void start();
+    static void stop();
+
+    static ticks_t now();
+    static bool has_passed(IN ticks_t deadline);
+    static bool has_reached(IN ticks_t timestamp, IN ticks_t deadline);
+
+  private:
+    SystemClock();
+};
+
+
+#endif
@@ -5,70 +5,103 @@
 
 
 // ============================================================================
-// CLASS Word FUNCTION DEFINITIONS
+// DEFINITIONS
 // ============================================================================
 
 
-Word::Word()
+#define ALL_LETTERS_MASK ((1UL << ALPHABET_LENGTH) - 1)
+
+
+// ============================================================================
+// STATIC FUNCTION DECLARATIONS
+// ============================================================================
+
+
+static bool is_letter(IN char character);
+static uint32_t get_letter_bit(IN char letter);
+
+template <uint8_t LENGTH>
+static void evaluate_guess_string_by_word(
+  IN basic_word_string_t<LENGTH> guess_string,
+  IN BasicWord<LENGTH>& target,
+  OUT basic_word_evaluation_t<LENGTH> evaluation
+);
+
+
+// ============================================================================
+// CLASS BasicWord FUNCTION DEFINITIONS
+// ============================================================================
+
+
+template <uint8_t LENGTH>
+BasicWord<LENGTH>::BasicWord()
 {
-  memset(letters, '\0', WORD_LENGTH);
+  memset(letters, '\0', LENGTH);
   return;
 }
 
 
-Word::Word(IN word_string_t string)
+template <uint8_t LENGTH>
+BasicWord<LENGTH>::BasicWord(IN basic_word_string_t<LENGTH> string)
 {
-  memcpy(letters, string, WORD_LENGTH);
+  memcpy(letters, string, LENGTH);
   return;
 }
 
 
-Word::~Word()
+template <uint8_t LENGTH>
+BasicWord<LENGTH>::~BasicWord()
 {
   return;
 }
 
 
-void Word::operator =(IN word_string_t string)
+template <uint8_t LENGTH>
+void BasicWord<LENGTH>::operator =(IN basic_word_string_t<LENGTH> string)
 {
-  memcpy(letters, string, WORD_LENGTH);
+  memcpy(letters, string, LENGTH);
   return;
 }
 
 
-char Word::operator [](IN uint8_t index) const
+template <uint8_t LENGTH>
+char BasicWord<LENGTH>::operator [](IN uint8_t index) const
 {
-  assert(index < WORD_LENGTH);
+  assert(index < LENGTH);
 
   return letters[index];
 }
 
 
-bool Word::operator <(IN Word& word) const
+template <uint8_t LENGTH>
+bool BasicWord<LENGTH>::operator <(IN BasicWord<LENGTH>& word) const
 {
-  int8_t result = strncmp(letters, word.letters, WORD_LENGTH);
+  int8_t result = strncmp(letters, word.letters, LENGTH);
 
   return (result < 0 ? true : false);
 }
 
 
-bool Word::operator >(IN Word& word) const
+template <uint8_t LENGTH>
+bool BasicWord<LENGTH>::operator >(IN BasicWord<LENGTH>& word) const
 {
-  int8_t result = strncmp(letters, word.letters, WORD_LENGTH);
+  int8_t result = strncmp(letters, word.letters, LENGTH);
 
   return (result > 0 ? true : false);
 }
 
 
-bool Word::operator ==(IN Word& word) const
+template <uint8_t LENGTH>
+bool BasicWord<LENGTH>::operator ==(IN BasicWord<LENGTH>& word) const
 {
-  int8_t result = strncmp(letters, word.letters, WORD_LENGTH);
+  int8_t result = strncmp(letters, word.letters, LENGTH);
 
   return (result == 0 ? true : false);
 }
 
 
-bool Word::operator !=(IN Word& word) const
+template <uint8_t LENGTH>
+bool BasicWord<LENGTH>::operator !=(IN BasicWord<LENGTH>& word) const
 {
   if ((*this) == word)
     return false;
@@ -77,9 +110,10 @@ bool Word::operator !=(IN Word& word) const
 }
 
 
-bool Word::is_empty() const
+template <uint8_t LENGTH>
+bool BasicWord<LENGTH>::is_empty() const
 {
-  for (uint8_t index = 0; index < WORD_LENGTH; index++)
+  for (uint8_t index = 0; index < LENGTH; index++)
   {
     if (letters[index] != '\0')
       return false;
@@ -89,12 +123,15 @@ bool Word::is_empty() const
 }
 
 
-bool Word::is_similar_to_word(IN Word& word) const
+template <uint8_t LENGTH>
+bool BasicWord<LENGTH>::is_similar_to_word(
+  IN BasicWord<LENGTH>& word
+) const
 {
   uint8_t index = 0;
   uint8_t num_letters_shared = 0;
 
-  while (index < WORD_LENGTH)
+  while (index < LENGTH)
   {
     if (letters[index] == word.letters[index])
     {
@@ -114,37 +151,46 @@ bool Word::is_similar_to_word(IN Word& word) const
 }
 
 
-bool Word::is_anagram_of_word(IN Word& word) const
+template <uint8_t LENGTH>
+bool BasicWord<LENGTH>::is_anagram_of_word(
+  IN BasicWord<LENGTH>& word
+) const
 {
-  word_string_t this_word_signature;
-  word_string_t given_word_signature;
+  basic_word_string_t<LENGTH> this_word_signature;
+  basic_word_string_t<LENGTH> given_word_signature;
 
   generate_letter_signature(this_word_signature);
   word.generate_letter_signature(given_word_signature);
 
   int8_t result = strncmp(
-    this_word_signature, given_word_signature, WORD_LENGTH
+    this_word_signature, given_word_signature, LENGTH
   );
 
   return (result == 0 ? true : false);
 }
 
 
-void Word::copy_into_string(OUT word_string_t string) const
+template <uint8_t LENGTH>
+void BasicWord<LENGTH>::copy_into_string(
+  OUT basic_word_string_t<LENGTH> string
+) const
 {
-  memcpy(string, letters, WORD_LENGTH);
+  memcpy(string, letters, LENGTH);
   return;
 }
 
 
-void Word::generate_letter_signature(OUT word_string_t signature) const
+template <uint8_t LENGTH>
+void BasicWord<LENGTH>::generate_letter_signature(
+  OUT basic_word_string_t<LENGTH> signature
+) const
 {
   char letter;
   int8_t subindex;
 
-  memcpy(signature, letters, WORD_LENGTH);
+  memcpy(signature, letters, LENGTH);
 
-  for (uint8_t index = 1; index < WORD_LENGTH; index++)
+  for (uint8_t index = 1; index < LENGTH; index++)
   {
     letter = signature[index];
     subindex = index - 1;
@@ -163,33 +209,38 @@ void Word::generate_letter_signature(OUT word_string_t signature) const
 
 
 // ============================================================================
-// CLASS WordPattern FUNCTION DEFINITIONS
+// CLASS BasicWordPattern FUNCTION DEFINITIONS
 // ============================================================================
 
 
-WordPattern::WordPattern()
+template <uint8_t LENGTH>
+BasicWordPattern<LENGTH>::BasicWordPattern()
 {
-  word_string_t default_pattern_string;
-  memset(default_pattern_string, this->WILDCARD_CHARACTER, WORD_LENGTH);
+  basic_word_string_t<LENGTH> default_pattern_string;
+  memset(default_pattern_string, this->WILDCARD_CHARACTER, LENGTH);
   set_pattern(default_pattern_string);
   return;
 }
 
 
-void WordPattern::set_pattern(IN word_string_t pattern_string)
+template <uint8_t LENGTH>
+void BasicWordPattern<LENGTH>::set_pattern(
+  IN basic_word_string_t<LENGTH> pattern_string
+)
 {
-  memcpy(this->pattern_string, pattern_string, WORD_LENGTH);
+  memcpy(this->pattern_string, pattern_string, LENGTH);
 
   assert(is_valid_pattern());
   return;
 }
 
 
-bool WordPattern::is_valid_pattern() const
+template <uint8_t LENGTH>
+bool BasicWordPattern<LENGTH>::is_valid_pattern() const
 {
   char character;
 
-  for (uint8_t index = 0; index < WORD_LENGTH; index++)
+  for (uint8_t index = 0; index < LENGTH; index++)
   {
     character = this->pattern_string[index];
 
@@ -204,9 +255,10 @@ bool WordPattern::is_valid_pattern() const
 }
 
 
-bool WordPattern::is_all_wildcards() const
+template <uint8_t LENGTH>
+bool BasicWordPattern<LENGTH>::is_all_wildcards() const
 {
-  for (uint8_t index = 0; index < WORD_LENGTH; index++)
+  for (uint8_t index = 0; index < LENGTH; index++)
   {
     if (pattern_string[index] != this->WILDCARD_CHARACTER)
       return false;
@@ -216,14 +268,17 @@ bool WordPattern::is_all_wildcards() const
 }
 
 
-bool WordPattern::matches_word(IN Word& word) const
+template <uint8_t LENGTH>
+bool BasicWordPattern<LENGTH>::matches_word(
+  IN BasicWord<LENGTH>& word
+) const
 {
-  word_string_t string;
+  basic_word_string_t<LENGTH> string;
   char character;
 
   word.copy_into_string(string);
 
-  for (uint8_t index = 0; index < WORD_LENGTH; index++)
+  for (uint8_t index = 0; index < LENGTH; index++)
   {
     character = pattern_string[index];
 
@@ -240,37 +295,383 @@ bool WordPattern::matches_word(IN Word& word) const
 }
 
 
+// ============================================================================
+// CLASS BasicCompiledWordPattern FUNCTION DEFINITIONS
+// ============================================================================
+
+
+template <uint8_t LENGTH>
+BasicCompiledWordPattern<LENGTH>::BasicCompiledWordPattern()
+{
+  reset();
+  return;
+}
+
+
+template <uint8_t LENGTH>
+void BasicCompiledWordPattern<LENGTH>::reset()
+{
+  for (uint8_t index = 0; index < LENGTH; index++)
+    allowed_letters[index] = ALL_LETTERS_MASK;
+
+  num_required_letters = 0;
+  return;
+}
+
+
+// Returns false and leaves the pattern unchanged if the string is malformed or
+// does not describe exactly LENGTH positions. Required letters are cleared.
+template <uint8_t LENGTH>
+bool BasicCompiledWordPattern<LENGTH>::compile(IN char* pattern_string)
+{
+  uint32_t masks[LENGTH];
+  uint8_t index = 0;
+  bool is_negated;
+
+  while (*pattern_string != '\0')
+  {
+    if (index == LENGTH)
+      return false;
+
+    if (*pattern_string == this->WILDCARD_CHARACTER)
+    {
+      masks[index] = ALL_LETTERS_MASK;
+    }
+    else if (*pattern_string == '[')
+    {
+      pattern_string++;
+      is_negated = (*pattern_string == '^');
+
+      if (is_negated)
+        pattern_string++;
+
+      masks[index] = 0;
+
+      while (*pattern_string != ']')
+      {
+        // This also catches a set that is never closed.
+        if (!is_letter(*pattern_string))
+          return false;
+
+        masks[index] |= get_letter_bit(*pattern_string);
+        pattern_string++;
+      }
+
+      if (is_negated)
+        masks[index] = ~masks[index] & ALL_LETTERS_MASK;
+    }
+    else if (is_letter(*pattern_string))
+    {
+      masks[index] = get_letter_bit(*pattern_string);
+    }
+    else
+    {
+      return false;
+    }
+
+    pattern_string++;
+    index++;
+  }
+
+  if (index != LENGTH)
+    return false;
+
+  memcpy(allowed_letters, masks, sizeof masks);
+  num_required_letters = 0;
+  return true;
+}
+
+
+template <uint8_t LENGTH>
+void BasicCompiledWordPattern<LENGTH>::set_letter(
+  IN uint8_t index, IN char letter
+)
+{
+  assert(index < LENGTH);
+  assert(is_letter(letter));
+
+  allowed_letters[index] = get_letter_bit(letter);
+  return;
+}
+
+
+template <uint8_t LENGTH>
+void BasicCompiledWordPattern<LENGTH>::exclude_letter(
+  IN uint8_t index, IN char letter
+)
+{
+  assert(index < LENGTH);
+  assert(is_letter(letter));
+
+  allowed_letters[index] &= ~get_letter_bit(letter);
+  return;
+}
+
+
+// Requires the word to contain at least `count` copies of the letter. Raising
+// the count of a letter that is already required replaces the old count.
+template <uint8_t LENGTH>
+void BasicCompiledWordPattern<LENGTH>::require_letter(
+  IN char letter, IN uint8_t count
+)
+{
+  assert(is_letter(letter));
+  assert(count <= LENGTH);
+
+  for (uint8_t index = 0; index < num_required_letters; index++)
+  {
+    if (required_letters[index] == letter)
+    {
+      if (count > required_counts[index])
+        required_counts[index] = count;
+
+      return;
+    }
+  }
+
+  assert(num_required_letters < LENGTH);
+
+  required_letters[num_required_letters] = letter;
+  required_counts[num_required_letters] = count;
+  num_required_letters++;
+  return;
+}
+
+
+template <uint8_t LENGTH>
+bool BasicCompiledWordPattern<LENGTH>::matches_word(
+  IN BasicWord<LENGTH>& word
+) const
+{
+  uint8_t count;
+
+  for (uint8_t index = 0; index < LENGTH; index++)
+  {
+    if (!(allowed_letters[index] & get_letter_bit(word[index])))
+      return false;
+  }
+
+  for (uint8_t index = 0; index < num_required_letters; index++)
+  {
+    count = 0;
+
+    for (uint8_t letter_index = 0; letter_index < LENGTH; letter_index++)
+    {
+      if (word[letter_index] == required_letters[index])
+        count++;
+    }
+
+    if (count < required_counts[index])
+      return false;
+  }
+
+  return true;
+}
+
+
+template <uint8_t LENGTH>
+uint32_t BasicCompiledWordPattern<LENGTH>::get_allowed_letters(
+  IN uint8_t index
+) const
+{
+  assert(index < LENGTH);
+
+  return allowed_letters[index];
+}
+
+
 // ============================================================================
 // PUBLIC FUNCTION DEFINITIONS
 // ============================================================================
 
 
+template <uint8_t LENGTH>
 void word_EvaluateFirstWordBySecondWord(
-  IN Word& guess, IN Word& target, OUT word_evaluation_t evaluation
+  IN BasicWord<LENGTH>& guess,
+  IN BasicWord<LENGTH>& target,
+  OUT basic_word_evaluation_t<LENGTH> evaluation
+)
+{
+  basic_word_string_t<LENGTH> guess_string;
+
+  guess.copy_into_string(guess_string);
+  evaluate_guess_string_by_word(guess_string, target, evaluation);
+  return;
+}
+
+
+// Evaluates one guess against several targets, writing one evaluation per
+// target. The guess is unpacked once for the whole batch.
+template <uint8_t LENGTH>
+void word_EvaluateGuessAgainstTargets(
+  IN BasicWord<LENGTH>& guess,
+  IN BasicWord<LENGTH>* targets,
+  IN uint8_t num_targets,
+  OUT basic_word_evaluation_t<LENGTH>* evaluations
+)
+{
+  basic_word_string_t<LENGTH> guess_string;
+
+  guess.copy_into_string(guess_string);
+
+  for (uint8_t index = 0; index < num_targets; index++)
+  {
+    evaluate_guess_string_by_word(
+      guess_string, targets[index], evaluations[index]
+    );
+  }
+
+  return;
+}
+
+
+template <uint8_t LENGTH>
+bool word_DoesEvaluationShowAllCorrect(
+  IN basic_word_evaluation_t<LENGTH> evaluation
 )
 {
+  for (uint8_t index = 0; index < LENGTH; index++)
+  {
+    if (evaluation[index] != POSITION_AND_LETTER_CORRECT)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+// Returns the same pattern as word_EncodeEvaluation() would for the result of
+// word_EvaluateFirstWordBySecondWord(), without the intermediate evaluation.
+// This is the fast path for code that evaluates one guess against many
+// targets.
+evaluation_pattern_t word_GetEvaluationPattern(
+  IN Word& guess, IN Word& target
+)
+{
+  const uint8_t POWERS_OF_THREE[WORD_LENGTH] = { 1, 3, 9, 27, 81 };
+
+  word_string_t guess_string;
   word_string_t target_string;
-  uint8_t subindex;
+  evaluation_pattern_t pattern = 0;
 
+  guess.copy_into_string(guess_string);
   target.copy_into_string(target_string);
-  memset(evaluation, UNEVALUATED, WORD_LENGTH);
 
+  // Matched letters are cleared in both strings so that they are not matched
+  // again below.
   for (uint8_t index = 0; index < WORD_LENGTH; index++)
   {
-    if (target_string[index] == guess[index])
+    if (target_string[index] == guess_string[index])
     {
-      evaluation[index] = POSITION_AND_LETTER_CORRECT;
+      pattern += 2 * POWERS_OF_THREE[index];
+      guess_string[index] = '\0';
       target_string[index] = '\0';
     }
   }
 
   for (uint8_t index = 0; index < WORD_LENGTH; index++)
+  {
+    if (guess_string[index] == '\0')
+      continue;
+
+    for (uint8_t subindex = 0; subindex < WORD_LENGTH; subindex++)
+    {
+      if (target_string[subindex] == guess_string[index])
+      {
+        pattern += POWERS_OF_THREE[index];
+        target_string[subindex] = '\0';
+        break;
+      }
+    }
+  }
+
+  return pattern;
+}
+
+
+evaluation_pattern_t word_EncodeEvaluation(IN word_evaluation_t evaluation)
+{
+  evaluation_pattern_t pattern = 0;
+  uint8_t index = WORD_LENGTH;
+
+  while (index > 0)
+  {
+    index--;
+    pattern = (
+      (3 * pattern) + (evaluation[index] - POSITION_AND_LETTER_INCORRECT)
+    );
+  }
+
+  return pattern;
+}
+
+
+void word_DecodeEvaluation(
+  IN evaluation_pattern_t pattern, OUT word_evaluation_t evaluation
+)
+{
+  evaluation_pattern_t remainder = pattern;
+
+  for (uint8_t index = 0; index < WORD_LENGTH; index++)
+  {
+    evaluation[index] = (evaluation_code_t)(
+      POSITION_AND_LETTER_INCORRECT + (remainder % 3)
+    );
+    remainder /= 3;
+  }
+
+  return;
+}
+
+
+// ============================================================================
+// STATIC FUNCTION DEFINITIONS
+// ============================================================================
+
+
+static bool is_letter(IN char character)
+{
+  return character >= 'A' && character <= 'Z';
+}
+
+
+static uint32_t get_letter_bit(IN char letter)
+{
+  return 1UL << (letter - 'A');
+}
+
+
+template <uint8_t LENGTH>
+static void evaluate_guess_string_by_word(
+  IN basic_word_string_t<LENGTH> guess_string,
+  IN BasicWord<LENGTH>& target,
+  OUT basic_word_evaluation_t<LENGTH> evaluation
+)
+{
+  basic_word_string_t<LENGTH> target_string;
+  uint8_t subindex;
+
+  target.copy_into_string(target_string);
+  memset(evaluation, UNEVALUATED, LENGTH);
+
+  for (uint8_t index = 0; index < LENGTH; index++)
+  {
+    if (target_string[index] == guess_string[index])
+    {
+      evaluation[index] = POSITION_AND_LETTER_CORRECT;
+      target_string[index] = '\0';
+    }
+  }
+
+  for (uint8_t index = 0; index < LENGTH; index++)
   {
     subindex = 0;
 
-    while (subindex < WORD_LENGTH && evaluation[index] == UNEVALUATED)
+    while (subindex < LENGTH && evaluation[index] == UNEVALUATED)
     {
-      if (target_string[subindex] == guess[index])
+      if (target_string[subindex] == guess_string[index])
       {
         evaluation[index] = LETTER_CORRECT;
         target_string[subindex] = '\0';
@@ -289,15 +690,29 @@ void word_EvaluateFirstWordBySecondWord(
 }
 
 
-bool word_DoesEvaluationShowAllCorrect(IN word_evaluation_t evaluation)
-{
-  for (uint8_t index = 0; index < WORD_LENGTH; index++)
-  {
-    if (evaluation[index] != POSITION_AND_LETTER_CORRECT)
-    {
-      return false;
-    }
-  }
+// ============================================================================
+// EXPLICIT INSTANTIATIONS
+// ============================================================================
 
-  return true;
-}
+
+template class BasicWord<WORD_LENGTH>;
+template class BasicWordPattern<WORD_LENGTH>;
+template class BasicCompiledWordPattern<WORD_LENGTH>;
+
+#define INSTANTIATE_WORD_FUNCTIONS(LENGTH) \
+  template void word_EvaluateFirstWordBySecondWord<LENGTH>( \
+    IN BasicWord<LENGTH>&, \
+    IN BasicWord<LENGTH>&, \
+    OUT basic_word_evaluation_t<LENGTH> \
+  ); \
+  template void word_EvaluateGuessAgainstTargets<LENGTH>( \
+    IN BasicWord<LENGTH>&, \
+    IN BasicWord<LENGTH>*, \
+    IN uint8_t, \
+    OUT basic_word_evaluation_t<LENGTH>* \
+  ); \
+  template bool word_DoesEvaluationShowAllCorrect<LENGTH>( \
+    IN basic_word_evaluation_t<LENGTH> \
+  )
+
+INSTANTIATE_WORD_FUNCTIONS(WORD_LENGTH);
@@ -12,8 +12,16 @@
 // ============================================================================
 
 
+// The game plays five-letter words, but the word core is a set of templates
+// on the word length so that other lengths can share it. Word, WordPattern,
+// and the word_* functions below are the five-letter instances.
 #define WORD_LENGTH (5)
-typedef char word_string_t[WORD_LENGTH];
+
+#define ALPHABET_LENGTH (26)
+
+template <uint8_t LENGTH>
+using basic_word_string_t = char[LENGTH];
+typedef basic_word_string_t<WORD_LENGTH> word_string_t;
 
 enum evaluation_code_t : uint8_t
 {
@@ -23,7 +31,17 @@ enum evaluation_code_t : uint8_t
   POSITION_AND_LETTER_CORRECT
 };
 
-typedef evaluation_code_t word_evaluation_t[WORD_LENGTH];
+template <uint8_t LENGTH>
+using basic_word_evaluation_t = evaluation_code_t[LENGTH];
+typedef basic_word_evaluation_t<WORD_LENGTH> word_evaluation_t;
+
+// An evaluation packed into a single base-3 number, where each position
+// contributes 0 (incorrect), 1 (letter correct), or 2 (position and letter
+// correct) times 3^index. All-correct packs to NUM_EVALUATION_PATTERNS - 1.
+// Longer words have more patterns than a byte can hold, so packing is only
+// defined for WORD_LENGTH.
+#define NUM_EVALUATION_PATTERNS (243)
+typedef uint8_t evaluation_pattern_t;
 
 
 // ============================================================================
@@ -31,59 +49,133 @@ typedef evaluation_code_t word_evaluation_t[WORD_LENGTH];
 // ============================================================================
 
 
-class Word
+template <uint8_t LENGTH>
+class BasicWord
 {
   public:
-    Word();
-    Word(IN word_string_t string);
-    ~Word();
+    BasicWord();
+    BasicWord(IN basic_word_string_t<LENGTH> string);
+    ~BasicWord();
 
-    void operator =(IN word_string_t string);
+    void operator =(IN basic_word_string_t<LENGTH> string);
     char operator [](IN uint8_t index) const;
-    bool operator <(IN Word& word) const;
-    bool operator >(IN Word& word) const;
-    bool operator ==(IN Word& word) const;
-    bool operator !=(IN Word& word) const;
+    bool operator <(IN BasicWord& word) const;
+    bool operator >(IN BasicWord& word) const;
+    bool operator ==(IN BasicWord& word) const;
+    bool operator !=(IN BasicWord& word) const;
 
     bool is_empty() const;
-    bool is_similar_to_word(IN Word& word) const;
-    bool is_anagram_of_word(IN Word& word) const;
+    bool is_similar_to_word(IN BasicWord& word) const;
+    bool is_anagram_of_word(IN BasicWord& word) const;
 
-    void copy_into_string(OUT word_string_t string) const;
-    void generate_letter_signature(OUT word_string_t signature) const;
+    void copy_into_string(OUT basic_word_string_t<LENGTH> string) const;
+    void generate_letter_signature(
+      OUT basic_word_string_t<LENGTH> signature
+    ) const;
 
   private:
-    word_string_t letters;
+    basic_word_string_t<LENGTH> letters;
 };
 
 
-class WordPattern
+template <uint8_t LENGTH>
+class BasicWordPattern
 {
   public:
     static const char WILDCARD_CHARACTER = '*';
 
-    WordPattern();
+    BasicWordPattern();
 
-    void set_pattern(IN word_string_t pattern_string);
+    void set_pattern(IN basic_word_string_t<LENGTH> pattern_string);
 
     bool is_valid_pattern() const;
     bool is_all_wildcards() const;
-    bool matches_word(IN Word& word) const;
+    bool matches_word(IN BasicWord<LENGTH>& word) const;
+
+  private:
+    basic_word_string_t<LENGTH> pattern_string;
+};
+
+
+// A pattern that is parsed once into a mask of allowed letters per position
+// (bit `n` stands for 'A' + n) and a short list of letters the word must
+// contain, so that matching is one mask test per letter.
+//
+// compile() takes one of the following for every position:
+//
+//   A       the letter A
+//   *       any letter
+//   [ABC]   any of the letters A, B, or C
+//   [^ABC]  any letter except A, B, or C
+//
+// For example, "*OU[NR][^S]" matches BOUND and COURT but not WOUNS.
+template <uint8_t LENGTH>
+class BasicCompiledWordPattern
+{
+  public:
+    static const char WILDCARD_CHARACTER = '*';
+
+    BasicCompiledWordPattern();
+
+    void reset();
+    bool compile(IN char* pattern_string);
+    void set_letter(IN uint8_t index, IN char letter);
+    void exclude_letter(IN uint8_t index, IN char letter);
+    void require_letter(IN char letter, IN uint8_t count);
+
+    bool matches_word(IN BasicWord<LENGTH>& word) const;
+    uint32_t get_allowed_letters(IN uint8_t index) const;
 
   private:
-    word_string_t pattern_string;
+    uint32_t allowed_letters[LENGTH];
+    char required_letters[LENGTH];
+    uint8_t required_counts[LENGTH];
+    uint8_t num_required_letters;
 };
 
 
+typedef BasicWord<WORD_LENGTH> Word;
+typedef BasicWordPattern<WORD_LENGTH> WordPattern;
+typedef BasicCompiledWordPattern<WORD_LENGTH> CompiledWordPattern;
+
+
 // ============================================================================
 // PUBLIC FUNCTION DECLARATIONS
 // ============================================================================
 
 
+template <uint8_t LENGTH>
 void word_EvaluateFirstWordBySecondWord(
-  IN Word& first_word, IN Word& second_word, OUT word_evaluation_t evaluation
+  IN BasicWord<LENGTH>& first_word,
+  IN BasicWord<LENGTH>& second_word,
+  OUT basic_word_evaluation_t<LENGTH> evaluation
+);
+template <uint8_t LENGTH>
+void word_EvaluateGuessAgainstTargets(
+  IN BasicWord<LENGTH>& guess,
+  IN BasicWord<LENGTH>* targets,
+  IN uint8_t num_targets,
+  OUT basic_word_evaluation_t<LENGTH>* evaluations
 );
-bool word_DoesEvaluationShowAllCorrect(IN word_evaluation_t evaluation);
+template <uint8_t LENGTH = WORD_LENGTH>
+bool word_DoesEvaluationShowAllCorrect(
+  IN basic_word_evaluation_t<LENGTH> evaluation
+);
+evaluation_pattern_t word_GetEvaluationPattern(
+  IN Word& guess, IN Word& target
+);
+evaluation_pattern_t word_EncodeEvaluation(IN word_evaluation_t evaluation);
+void word_DecodeEvaluation(
+  IN evaluation_pattern_t pattern, OUT word_evaluation_t evaluation
+);
+
+
+// The template definitions live in word.cpp, which only instantiates them for
+// the lengths that a gameplay mode plays, so that the calculator binary does
+// not carry unused copies. Another length needs a line there and here.
+extern template class BasicWord<WORD_LENGTH>;
+extern template class BasicWordPattern<WORD_LENGTH>;
+extern template class BasicCompiledWordPattern<WORD_LENGTH>;
 
 
 #endif
@@ -0,0 +1,55 @@
+#include <stddef.h>
+
+#include "../../../../src/dictionary.h"
+#include "../../../test_utils.h"
+
+
+static bool test(void);
+
+
+int main(void)
+{
+  testutil_PrintTestSetup();
+  testutil_PrintTestResults(test());
+  return 0;
+}
+
+
+static bool test(void)
+{
+  const uint8_t NUM_TRIES = 10;
+
+  Dictionary dictionary;
+  CompiledWordPattern pattern;
+  CompiledWordPattern excluded_patterns[2];
+  Word crank("CRANK");
+  Word word;
+
+  pattern.compile("CRAN*");
+  excluded_patterns[0].compile("****E");
+  excluded_patterns[1].compile("****K");
+
+  for (uint8_t index = 0; index < NUM_TRIES; index++)
+  {
+    if (
+      !dictionary.get_random_word_that_fits_pattern(
+        pattern, excluded_patterns, 1, word
+      )
+      || word != crank
+    )
+      return false;
+  }
+
+  // No word is left, so the word must not change.
+  if (
+    dictionary.get_random_word_that_fits_pattern(
+      pattern, excluded_patterns, 2, word
+    )
+    || word != crank
+  )
+    return false;
+
+  pattern.compile("QQQQQ");
+
+  return !dictionary.get_random_word_that_fits_pattern(pattern, NULL, 0, word);
+}
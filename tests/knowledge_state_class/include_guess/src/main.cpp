@@ -0,0 +1,39 @@
+#include "../../../../src/knowledge.h"
+#include "../../../../src/word.h"
+#include "../../../test_utils.h"
+
+
+static bool test(void);
+
+
+int main(void)
+{
+  testutil_PrintTestSetup();
+  testutil_PrintTestResults(test());
+  return 0;
+}
+
+
+static bool test(void)
+{
+  KnowledgeState knowledge;
+  Word target("SPADE");
+  Word first_guess("SPEED");
+  Word second_guess("SPOON");
+  word_evaluation_t evaluation;
+
+  word_EvaluateFirstWordBySecondWord(first_guess, target, evaluation);
+  knowledge.include_guess(first_guess, evaluation);
+  word_EvaluateFirstWordBySecondWord(second_guess, target, evaluation);
+  knowledge.include_guess(second_guess, evaluation);
+
+  return (
+    knowledge.get_letter_status('S') == KnowledgeState::PLACED
+    && knowledge.get_letter_status('P') == KnowledgeState::PLACED
+    && knowledge.get_letter_status('E') == KnowledgeState::PRESENT
+    && knowledge.get_letter_status('D') == KnowledgeState::PRESENT
+    && knowledge.get_letter_status('O') == KnowledgeState::ABSENT
+    && knowledge.get_letter_status('N') == KnowledgeState::ABSENT
+    && knowledge.get_letter_status('A') == KnowledgeState::UNKNOWN
+  );
+}
@@ -0,0 +1,35 @@
+#include "../../../../src/knowledge.h"
+#include "../../../../src/word.h"
+#include "../../../test_utils.h"
+
+
+static bool test(void);
+
+
+int main(void)
+{
+  testutil_PrintTestSetup();
+  testutil_PrintTestResults(test());
+  return 0;
+}
+
+
+static bool test(void)
+{
+  KnowledgeState knowledge;
+  Word target("ABIDE");
+  Word guess("SPEED");
+  Word misplaced_letter("ADIEU");
+  Word too_many_letters("EDGED");
+  word_evaluation_t evaluation;
+
+  word_EvaluateFirstWordBySecondWord(guess, target, evaluation);
+  knowledge.include_guess(guess, evaluation);
+
+  return (
+    knowledge.is_consistent(target)
+    && !knowledge.is_consistent(guess)
+    && !knowledge.is_consistent(misplaced_letter)
+    && !knowledge.is_consistent(too_many_letters)
+  );
+}
@@ -0,0 +1,42 @@
+#include <string.h>
+
+#include "../../../../src/word.h"
+#include "../../../test_utils.h"
+
+
+static bool test(void);
+
+
+int main(void)
+{
+  testutil_PrintTestSetup();
+  testutil_PrintTestResults(test());
+  return 0;
+}
+
+
+static bool test(void)
+{
+  const uint8_t NUM_TARGETS = 4;
+
+  Word guess("SPEED");
+  Word targets[NUM_TARGETS] = {
+    Word("ABIDE"), Word("SPEED"), Word("ERASE"), Word("DEEPS")
+  };
+  word_evaluation_t evaluations[NUM_TARGETS];
+  word_evaluation_t expected_evaluation;
+
+  word_EvaluateGuessAgainstTargets(guess, targets, NUM_TARGETS, evaluations);
+
+  for (uint8_t index = 0; index < NUM_TARGETS; index++)
+  {
+    word_EvaluateFirstWordBySecondWord(
+      guess, targets[index], expected_evaluation
+    );
+
+    if (memcmp(evaluations[index], expected_evaluation, WORD_LENGTH) != 0)
+      return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,57 @@
+#include "../../../../src/word.h"
+#include "../../../test_utils.h"
+
+
+static bool test(void);
+
+
+int main(void)
+{
+  testutil_PrintTestSetup();
+  testutil_PrintTestResults(test());
+  return 0;
+}
+
+
+static bool test(void)
+{
+  const uint8_t NUM_WORDS = 4;
+  const char* WORDS[NUM_WORDS] = { "BOUND", "COURT", "MOUNS", "CRANE" };
+  const bool EXPECTED_MATCHES[NUM_WORDS] = { true, true, false, false };
+
+  CompiledWordPattern pattern;
+
+  if (pattern.compile("*OU[NR"))
+    return false;
+
+  if (pattern.compile("*OU[NR][^S]*"))
+    return false;
+
+  if (!pattern.compile("*OU[NR][^S]"))
+    return false;
+
+  for (uint8_t index = 0; index < NUM_WORDS; index++)
+  {
+    if (pattern.matches_word(Word(WORDS[index])) != EXPECTED_MATCHES[index])
+      return false;
+  }
+
+  pattern.require_letter('T', 1);
+
+  if (
+    pattern.matches_word(Word("BOUND"))
+    || !pattern.matches_word(Word("COURT"))
+  )
+    return false;
+
+  pattern.reset();
+  pattern.require_letter('E', 2);
+
+  if (
+    pattern.matches_word(Word("CRANE"))
+    || !pattern.matches_word(Word("GEESE"))
+  )
+    return false;
+
+  return true;
+}
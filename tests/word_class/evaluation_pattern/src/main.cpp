@@ -0,0 +1,39 @@
+#include "../../../../src/word.h"
+#include "../../../test_utils.h"
+
+
+static bool test(void);
+
+
+int main(void)
+{
+  testutil_PrintTestSetup();
+  testutil_PrintTestResults(test());
+  return 0;
+}
+
+
+static bool test(void)
+{
+  const uint8_t NUM_PAIRS = 4;
+  const char* GUESSES[NUM_PAIRS] = { "SPEED", "LLAMA", "ABIDE", "CRANE" };
+  const char* TARGETS[NUM_PAIRS] = { "ABIDE", "HELLO", "ABIDE", "NACRE" };
+
+  word_evaluation_t evaluation;
+
+  for (uint8_t index = 0; index < NUM_PAIRS; index++)
+  {
+    Word guess(GUESSES[index]);
+    Word target(TARGETS[index]);
+
+    word_EvaluateFirstWordBySecondWord(guess, target, evaluation);
+
+    if (
+      word_GetEvaluationPattern(guess, target)
+      != word_EncodeEvaluation(evaluation)
+    )
+      return false;
+  }
+
+  return true;
+}
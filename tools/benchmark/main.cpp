@@ -0,0 +1,297 @@
+#include <fileioc.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+
+#include "../../src/dictionary.h"
+#include "../../src/word.h"
+#include "../common/batchevaluation.h"
+#include "strategy.h"
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+#define DEFAULT_APPVAR_DIRECTORY ("../appvars")
+#define DEFAULT_RANDOM_SEED      (1)
+
+// A game counts as a failure if it is not solved within MAX_NUM_GUESSES, but
+// it is played on (up to GUESS_LIMIT) so the average stays meaningful.
+#define MAX_NUM_GUESSES (5)
+#define GUESS_LIMIT     (20)
+
+typedef struct
+{
+  uint32_t num_games;
+  uint64_t total_num_guesses;
+  uint32_t num_failures;
+  uint32_t num_unsolved;
+  uint8_t max_num_guesses;
+  double seconds;
+} benchmark_result_t;
+
+
+// ============================================================================
+// STATIC FUNCTION DECLARATIONS
+// ============================================================================
+
+
+static bool load_words(OUT std::vector<Word>& words);
+static uint8_t play_game(
+  MOD Strategy& strategy,
+  IN std::vector<Word>& words,
+  IN AnswerBatch& answers,
+  IN word_index_t target
+);
+static void filter_candidates(
+  IN evaluation_pattern_t* patterns,
+  IN evaluation_pattern_t pattern,
+  MOD std::vector<word_index_t>& candidates
+);
+static void run_benchmark(
+  MOD Strategy& strategy,
+  IN std::vector<Word>& words,
+  IN AnswerBatch& answers,
+  IN uint32_t num_targets,
+  OUT benchmark_result_t& result
+);
+static void print_result(
+  IN char* strategy_name, IN benchmark_result_t& result
+);
+static void print_usage(IN char* program_name);
+
+
+// ============================================================================
+// MAIN FUNCTION
+// ============================================================================
+
+
+int main(int argc, char** argv)
+{
+  const char* appvar_directory = DEFAULT_APPVAR_DIRECTORY;
+  const char* strategy_name = NULL;
+  uint32_t num_targets = 0;
+  unsigned int seed = DEFAULT_RANDOM_SEED;
+
+  std::vector<Word> words;
+  std::vector<Strategy*> strategies;
+  benchmark_result_t result;
+
+  for (int index = 1; index < argc; index++)
+  {
+    if (!strcmp(argv[index], "-a") && index + 1 < argc)
+      appvar_directory = argv[++index];
+    else if (!strcmp(argv[index], "-s") && index + 1 < argc)
+      strategy_name = argv[++index];
+    else if (!strcmp(argv[index], "-n") && index + 1 < argc)
+      num_targets = atoi(argv[++index]);
+    else if (!strcmp(argv[index], "-r") && index + 1 < argc)
+      seed = atoi(argv[++index]);
+    else
+    {
+      print_usage(argv[0]);
+      return 1;
+    }
+  }
+
+  shim_SetAppvarDirectory(appvar_directory);
+
+  if (!load_words(words))
+  {
+    fprintf(
+      stderr,
+      "Could not read %s/%s.8xv\n",
+      appvar_directory,
+      DICTIONARY_APPVAR
+    );
+    return 1;
+  }
+
+  if (num_targets == 0 || num_targets > words.size())
+    num_targets = words.size();
+
+  AnswerBatch answers(words);
+
+  strategies.push_back(new RandomConsistentStrategy(words, answers, seed));
+  strategies.push_back(new EntropyStrategy(words, answers));
+  strategies.push_back(new FrequencyStrategy(words, answers));
+
+  printf("Dictionary: %u words\n", (unsigned int)words.size());
+  printf("Targets:    %u\n", num_targets);
+  printf("Kernel:     %s\n", batch_GetKernelName());
+  printf(
+    "\n%-18s %10s %10s %10s %8s %10s\n",
+    "Strategy", "Average", "Failures", "Unsolved", "Worst", "Games/s"
+  );
+
+  for (Strategy* strategy : strategies)
+  {
+    if (strategy_name == NULL || !strcmp(strategy_name, strategy->get_name()))
+    {
+      run_benchmark(*strategy, words, answers, num_targets, result);
+      print_result(strategy->get_name(), result);
+    }
+  }
+
+  for (Strategy* strategy : strategies)
+    delete strategy;
+
+  return 0;
+}
+
+
+// ============================================================================
+// STATIC FUNCTION DEFINITIONS
+// ============================================================================
+
+
+// Goes through the game's own Dictionary class so that the benchmark also
+// exercises the appvar loading code.
+static bool load_words(OUT std::vector<Word>& words)
+{
+  Dictionary dictionary;
+
+  if (!dictionary.is_loaded())
+    return false;
+
+  words.clear();
+
+  for (uint32_t index = 0; index < dictionary.get_num_words(); index++)
+    words.push_back(Word(dictionary[index]));
+
+  return !words.empty();
+}
+
+
+// Returns the number of guesses needed, or GUESS_LIMIT + 1 if the game was
+// not solved.
+static uint8_t play_game(
+  MOD Strategy& strategy,
+  IN std::vector<Word>& words,
+  IN AnswerBatch& answers,
+  IN word_index_t target
+)
+{
+  std::vector<word_index_t> candidates(words.size());
+  std::vector<evaluation_pattern_t> patterns(words.size());
+  word_index_t guess;
+
+  for (uint32_t index = 0; index < words.size(); index++)
+    candidates[index] = index;
+
+  strategy.start_game();
+
+  for (uint8_t num_guesses = 1; num_guesses <= GUESS_LIMIT; num_guesses++)
+  {
+    guess = strategy.choose_guess(candidates);
+
+    if (guess == target)
+      return num_guesses;
+
+    batch_EvaluateGuess(words[guess], answers, patterns.data());
+    filter_candidates(patterns.data(), patterns[target], candidates);
+  }
+
+  return GUESS_LIMIT + 1;
+}
+
+
+// `patterns` holds the evaluation of the guess against every word.
+static void filter_candidates(
+  IN evaluation_pattern_t* patterns,
+  IN evaluation_pattern_t pattern,
+  MOD std::vector<word_index_t>& candidates
+)
+{
+  uint32_t num_kept = 0;
+
+  for (word_index_t candidate : candidates)
+  {
+    if (patterns[candidate] == pattern)
+      candidates[num_kept++] = candidate;
+  }
+
+  candidates.resize(num_kept);
+  return;
+}
+
+
+static void run_benchmark(
+  MOD Strategy& strategy,
+  IN std::vector<Word>& words,
+  IN AnswerBatch& answers,
+  IN uint32_t num_targets,
+  OUT benchmark_result_t& result
+)
+{
+  const std::chrono::steady_clock::time_point START = (
+    std::chrono::steady_clock::now()
+  );
+
+  uint8_t num_guesses;
+
+  memset(&result, 0, sizeof result);
+
+  for (uint32_t target = 0; target < num_targets; target++)
+  {
+    num_guesses = play_game(strategy, words, answers, target);
+    result.num_games++;
+
+    if (num_guesses > GUESS_LIMIT)
+    {
+      result.num_unsolved++;
+      result.num_failures++;
+      continue;
+    }
+
+    result.total_num_guesses += num_guesses;
+
+    if (num_guesses > result.max_num_guesses)
+      result.max_num_guesses = num_guesses;
+
+    if (num_guesses > MAX_NUM_GUESSES)
+      result.num_failures++;
+  }
+
+  result.seconds = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - START
+  ).count();
+  return;
+}
+
+
+static void print_result(
+  IN char* strategy_name, IN benchmark_result_t& result
+)
+{
+  const uint32_t NUM_SOLVED = result.num_games - result.num_unsolved;
+
+  printf(
+    "%-18s %10.4f %9.2f%% %10u %8u %10.1f\n",
+    strategy_name,
+    NUM_SOLVED ? (double)result.total_num_guesses / NUM_SOLVED : 0.0,
+    100.0 * result.num_failures / result.num_games,
+    result.num_unsolved,
+    result.max_num_guesses,
+    result.seconds > 0.0 ? result.num_games / result.seconds : 0.0
+  );
+  return;
+}
+
+
+static void print_usage(IN char* program_name)
+{
+  fprintf(
+    stderr,
+    "Usage: %s [-a appvar_directory] [-s strategy] [-n num_targets] "
+    "[-r seed]\n"
+    "Strategies: random-consistent, entropy, frequency\n",
+    program_name
+  );
+  return;
+}
@@ -0,0 +1,225 @@
+#include <math.h>
+#include <stdlib.h>
+
+#include "strategy.h"
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+#define ALPHABET_LENGTH (26)
+
+
+// ============================================================================
+// CLASS Strategy FUNCTION DEFINITIONS
+// ============================================================================
+
+
+Strategy::Strategy(
+  IN char* name, IN std::vector<Word>& words, IN AnswerBatch& answers
+)
+: words(words), answers(answers), name(name)
+{
+  return;
+}
+
+
+void Strategy::start_game()
+{
+  return;
+}
+
+
+const char* Strategy::get_name() const
+{
+  return name;
+}
+
+
+// ============================================================================
+// CLASS RandomConsistentStrategy FUNCTION DEFINITIONS
+// ============================================================================
+
+
+RandomConsistentStrategy::RandomConsistentStrategy(
+  IN std::vector<Word>& words,
+  IN AnswerBatch& answers,
+  IN unsigned int seed
+)
+: Strategy("random-consistent", words, answers), SEED(seed)
+{
+  random_state = seed;
+  game_number = 0;
+  return;
+}
+
+
+void RandomConsistentStrategy::start_game()
+{
+  // Reseed per game so that a game's guesses depend only on its target, not
+  // on how many games were played before it.
+  random_state = SEED + game_number++;
+  return;
+}
+
+
+word_index_t RandomConsistentStrategy::choose_guess(
+  IN std::vector<word_index_t>& candidates
+)
+{
+  return candidates[rand_r(&random_state) % candidates.size()];
+}
+
+
+// ============================================================================
+// CLASS EntropyStrategy FUNCTION DEFINITIONS
+// ============================================================================
+
+
+EntropyStrategy::EntropyStrategy(
+  IN std::vector<Word>& words, IN AnswerBatch& answers
+)
+: Strategy("entropy", words, answers)
+{
+  opening_guess_cached = false;
+  opening_guess = 0;
+  patterns.resize(words.size());
+  return;
+}
+
+
+word_index_t EntropyStrategy::choose_guess(
+  IN std::vector<word_index_t>& candidates
+)
+{
+  const bool IS_OPENING_GUESS = (candidates.size() == words.size());
+
+  word_index_t best_guess = candidates[0];
+  double best_entropy = -1.0;
+  double entropy;
+
+  if (IS_OPENING_GUESS && opening_guess_cached)
+    return opening_guess;
+
+  if (candidates.size() <= 2)
+    return candidates[0];
+
+  for (word_index_t guess : candidates)
+  {
+    entropy = get_entropy(guess, candidates);
+
+    if (entropy > best_entropy)
+    {
+      best_guess = guess;
+      best_entropy = entropy;
+    }
+  }
+
+  if (IS_OPENING_GUESS)
+  {
+    opening_guess = best_guess;
+    opening_guess_cached = true;
+  }
+
+  return best_guess;
+}
+
+
+double EntropyStrategy::get_entropy(
+  IN word_index_t guess, IN std::vector<word_index_t>& candidates
+)
+{
+  const double NUM_CANDIDATES = candidates.size();
+
+  uint32_t bucket_sizes[NUM_EVALUATION_PATTERNS] = { 0 };
+  double entropy = 0.0;
+  double probability;
+
+  // Evaluating against every answer with the vector kernel is cheaper than
+  // evaluating only the candidates one at a time.
+  batch_EvaluateGuess(words[guess], answers, patterns.data());
+
+  for (word_index_t target : candidates)
+    bucket_sizes[patterns[target]]++;
+
+  for (uint32_t bucket_size : bucket_sizes)
+  {
+    if (bucket_size > 0)
+    {
+      probability = bucket_size / NUM_CANDIDATES;
+      entropy -= probability * log2(probability);
+    }
+  }
+
+  return entropy;
+}
+
+
+// ============================================================================
+// CLASS FrequencyStrategy FUNCTION DEFINITIONS
+// ============================================================================
+
+
+FrequencyStrategy::FrequencyStrategy(
+  IN std::vector<Word>& words, IN AnswerBatch& answers
+)
+: Strategy("frequency", words, answers)
+{
+  return;
+}
+
+
+word_index_t FrequencyStrategy::choose_guess(
+  IN std::vector<word_index_t>& candidates
+)
+{
+  uint32_t letter_counts[ALPHABET_LENGTH] = { 0 };
+  word_index_t best_guess = candidates[0];
+  uint32_t best_score = 0;
+  uint32_t letters_seen;
+  uint32_t score;
+  uint8_t letter;
+
+  for (word_index_t candidate : candidates)
+  {
+    letters_seen = 0;
+
+    for (uint8_t index = 0; index < WORD_LENGTH; index++)
+    {
+      letter = words[candidate][index] - 'A';
+
+      if (!(letters_seen & (1UL << letter)))
+      {
+        letters_seen |= (1UL << letter);
+        letter_counts[letter]++;
+      }
+    }
+  }
+
+  for (word_index_t candidate : candidates)
+  {
+    letters_seen = 0;
+    score = 0;
+
+    for (uint8_t index = 0; index < WORD_LENGTH; index++)
+    {
+      letter = words[candidate][index] - 'A';
+
+      if (!(letters_seen & (1UL << letter)))
+      {
+        letters_seen |= (1UL << letter);
+        score += letter_counts[letter];
+      }
+    }
+
+    if (score > best_score)
+    {
+      best_guess = candidate;
+      best_score = score;
+    }
+  }
+
+  return best_guess;
+}
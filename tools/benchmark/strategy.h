@@ -0,0 +1,106 @@
+#ifndef STRATEGY_H
+#define STRATEGY_H
+
+
+#include <stdint.h>
+#include <vector>
+
+#include "../../src/typehints.h"
+#include "../../src/word.h"
+#include "../common/batchevaluation.h"
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+typedef uint16_t word_index_t;
+
+
+// ============================================================================
+// CLASS DECLARATIONS
+// ============================================================================
+
+
+// A guessing strategy picks the next guess from the words that are still
+// consistent with every evaluation seen so far. `words` is the whole
+// dictionary, `answers` holds the same words for batch evaluation, and both
+// stay the same for the lifetime of the strategy.
+class Strategy
+{
+  public:
+    Strategy(
+      IN char* name, IN std::vector<Word>& words, IN AnswerBatch& answers
+    );
+    virtual ~Strategy() {}
+
+    virtual void start_game();
+    virtual word_index_t choose_guess(
+      IN std::vector<word_index_t>& candidates
+    ) = 0;
+
+    const char* get_name() const;
+
+  protected:
+    const std::vector<Word>& words;
+    const AnswerBatch& answers;
+
+  private:
+    const char* name;
+};
+
+
+// Guesses a random word that could still be the target.
+class RandomConsistentStrategy : public Strategy
+{
+  public:
+    RandomConsistentStrategy(
+      IN std::vector<Word>& words,
+      IN AnswerBatch& answers,
+      IN unsigned int seed
+    );
+
+    void start_game();
+    word_index_t choose_guess(IN std::vector<word_index_t>& candidates);
+
+  private:
+    const unsigned int SEED;
+    unsigned int random_state;
+    uint32_t game_number;
+};
+
+
+// Guesses the candidate whose evaluation tells the most about the remaining
+// candidates (highest Shannon entropy). The opener is the same in every game,
+// so it is computed once and cached.
+class EntropyStrategy : public Strategy
+{
+  public:
+    EntropyStrategy(IN std::vector<Word>& words, IN AnswerBatch& answers);
+
+    word_index_t choose_guess(IN std::vector<word_index_t>& candidates);
+
+  private:
+    bool opening_guess_cached;
+    word_index_t opening_guess;
+    std::vector<evaluation_pattern_t> patterns;
+
+    double get_entropy(
+      IN word_index_t guess, IN std::vector<word_index_t>& candidates
+    );
+};
+
+
+// Guesses the candidate whose distinct letters appear in the most remaining
+// candidates.
+class FrequencyStrategy : public Strategy
+{
+  public:
+    FrequencyStrategy(IN std::vector<Word>& words, IN AnswerBatch& answers);
+
+    word_index_t choose_guess(IN std::vector<word_index_t>& candidates);
+};
+
+
+#endif
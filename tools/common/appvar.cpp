@@ -0,0 +1,195 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "appvar.h"
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+// Layout of a .8xv file:
+//
+//   [ 8] "**TI83F*"
+//   [ 3] 0x1A 0x0A 0x00
+//   [42] Comment
+//   [ 2] Length of the variable entry that follows
+//   [ 2] Variable header length (0x0D)
+//   [ 2] Variable data length
+//   [ 1] Variable type (0x15 for appvars)
+//   [ 8] Variable name, zero-padded
+//   [ 1] Version
+//   [ 1] Flag (0x80 if archived)
+//   [ 2] Variable data length (again)
+//   [ 2] Appvar size
+//   [..] Appvar data
+//   [ 2] Checksum of the variable entry
+
+#define FILE_SIGNATURE        ("**TI83F*\x1A\x0A\x00")
+#define FILE_SIGNATURE_LENGTH (11)
+#define COMMENT_LENGTH        (42)
+#define FILE_HEADER_LENGTH    (FILE_SIGNATURE_LENGTH + COMMENT_LENGTH + 2)
+#define VARIABLE_HEADER_LENGTH (13)
+#define APPVAR_TYPE           (0x15)
+#define ARCHIVED_FLAG         (0x80)
+
+
+// ============================================================================
+// STATIC FUNCTION DECLARATIONS
+// ============================================================================
+
+
+static uint16_t read_uint16(IN uint8_t* bytes);
+
+
+// ============================================================================
+// PUBLIC FUNCTION DEFINITIONS
+// ============================================================================
+
+
+bool appvar_Read(IN char* path, OUT std::vector<uint8_t>& data)
+{
+  std::vector<uint8_t> contents;
+  uint8_t buffer[4096];
+  size_t num_bytes_read;
+  size_t offset;
+  uint16_t variable_header_length;
+  uint16_t appvar_size;
+  FILE* file;
+
+  if ((file = fopen(path, "rb")) == NULL)
+    return false;
+
+  while ((num_bytes_read = fread(buffer, 1, sizeof buffer, file)) > 0)
+    contents.insert(contents.end(), buffer, buffer + num_bytes_read);
+
+  fclose(file);
+
+  if (
+    contents.size() < FILE_HEADER_LENGTH + VARIABLE_HEADER_LENGTH + 4
+    || memcmp(contents.data(), FILE_SIGNATURE, FILE_SIGNATURE_LENGTH) != 0
+  )
+  {
+    return false;
+  }
+
+  offset = FILE_HEADER_LENGTH;
+  variable_header_length = read_uint16(contents.data() + offset);
+
+  if (contents[offset + 4] != APPVAR_TYPE)
+    return false;
+
+  // Skip the header, then the repeated variable data length field.
+  offset += 2 + variable_header_length;
+  offset += 2;
+
+  if (offset + 2 > contents.size())
+    return false;
+
+  appvar_size = read_uint16(contents.data() + offset);
+  offset += 2;
+
+  if (offset + appvar_size > contents.size())
+    return false;
+
+  data.assign(
+    contents.begin() + offset, contents.begin() + offset + appvar_size
+  );
+  return true;
+}
+
+
+bool appvar_Write(
+  IN char* path,
+  IN char* name,
+  IN std::vector<uint8_t>& data,
+  IN bool archived
+)
+{
+  const uint16_t VARIABLE_DATA_LENGTH = data.size() + 2;
+  const uint16_t ENTRY_LENGTH = (
+    2 + VARIABLE_HEADER_LENGTH + VARIABLE_DATA_LENGTH
+  );
+
+  std::vector<uint8_t> entry;
+  uint8_t header[FILE_HEADER_LENGTH] = { 0 };
+  uint16_t checksum = 0;
+  size_t name_length = strlen(name);
+  FILE* file;
+
+  if (
+    name_length > APPVAR_MAX_NAME_LENGTH
+    || data.size() > APPVAR_MAX_DATA_SIZE
+  )
+  {
+    return false;
+  }
+
+  appvar_AppendUint16(entry, VARIABLE_HEADER_LENGTH);
+  appvar_AppendUint16(entry, VARIABLE_DATA_LENGTH);
+  entry.push_back(APPVAR_TYPE);
+
+  for (size_t index = 0; index < APPVAR_MAX_NAME_LENGTH; index++)
+    entry.push_back(index < name_length ? name[index] : '\0');
+
+  entry.push_back(0);
+  entry.push_back(archived ? ARCHIVED_FLAG : 0);
+  appvar_AppendUint16(entry, VARIABLE_DATA_LENGTH);
+  appvar_AppendUint16(entry, data.size());
+  entry.insert(entry.end(), data.begin(), data.end());
+
+  for (uint8_t byte : entry)
+    checksum += byte;
+
+  memcpy(header, FILE_SIGNATURE, FILE_SIGNATURE_LENGTH);
+  snprintf(
+    (char*)header + FILE_SIGNATURE_LENGTH, COMMENT_LENGTH, "Gimme 5: %s", name
+  );
+  header[FILE_HEADER_LENGTH - 2] = ENTRY_LENGTH & 0xFF;
+  header[FILE_HEADER_LENGTH - 1] = ENTRY_LENGTH >> 8;
+
+  if ((file = fopen(path, "wb")) == NULL)
+    return false;
+
+  fwrite(header, 1, sizeof header, file);
+  fwrite(entry.data(), 1, entry.size(), file);
+  fputc(checksum & 0xFF, file);
+  fputc(checksum >> 8, file);
+  fclose(file);
+  return true;
+}
+
+
+void appvar_AppendUint16(MOD std::vector<uint8_t>& data, IN uint16_t value)
+{
+  data.push_back(value & 0xFF);
+  data.push_back(value >> 8);
+  return;
+}
+
+
+void appvar_AppendUint24(MOD std::vector<uint8_t>& data, IN uint32_t value)
+{
+  data.push_back(value & 0xFF);
+  data.push_back((value >> 8) & 0xFF);
+  data.push_back((value >> 16) & 0xFF);
+  return;
+}
+
+
+uint32_t appvar_ReadUint24(IN uint8_t* bytes)
+{
+  return bytes[0] | (bytes[1] << 8) | ((uint32_t)bytes[2] << 16);
+}
+
+
+// ============================================================================
+// STATIC FUNCTION DEFINITIONS
+// ============================================================================
+
+
+static uint16_t read_uint16(IN uint8_t* bytes)
+{
+  return bytes[0] | (bytes[1] << 8);
+}
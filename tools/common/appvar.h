@@ -0,0 +1,43 @@
+#ifndef APPVAR_H
+#define APPVAR_H
+
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "../../src/typehints.h"
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+#define APPVAR_MAX_NAME_LENGTH (8)
+#define APPVAR_MAX_DATA_SIZE   (65505)
+
+
+// ============================================================================
+// PUBLIC FUNCTION DECLARATIONS
+// ============================================================================
+
+
+// Reads the data section of the first appvar in a .8xv file. The two-byte
+// size field that TI-OS stores in front of the data is not included.
+bool appvar_Read(IN char* path, OUT std::vector<uint8_t>& data);
+
+// Writes `data` into a new .8xv file as an appvar named `name`.
+bool appvar_Write(
+  IN char* path,
+  IN char* name,
+  IN std::vector<uint8_t>& data,
+  IN bool archived
+);
+
+void appvar_AppendUint16(MOD std::vector<uint8_t>& data, IN uint16_t value);
+void appvar_AppendUint24(MOD std::vector<uint8_t>& data, IN uint32_t value);
+uint32_t appvar_ReadUint24(IN uint8_t* bytes);
+
+
+#endif
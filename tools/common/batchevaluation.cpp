@@ -0,0 +1,277 @@
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "batchevaluation.h"
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+// Both kernels follow word_EvaluateFirstWordBySecondWord(): greens first, then
+// each remaining guess letter, in order, claims the first unclaimed matching
+// answer letter. Every mask is a byte per answer, all ones or all zeros, and
+// a pattern never exceeds 242 so it fits in a byte lane.
+
+#if defined(__AVX2__)
+
+typedef __m256i vector_t;
+
+#define KERNEL_NAME        ("AVX2")
+#define VECTOR_LOAD(x)     _mm256_loadu_si256((const vector_t*)(x))
+#define VECTOR_STORE(x, y) _mm256_storeu_si256((vector_t*)(x), (y))
+#define VECTOR_SET1(x)     _mm256_set1_epi8((char)(x))
+#define VECTOR_ZERO()      _mm256_setzero_si256()
+#define VECTOR_EQUAL(x, y) _mm256_cmpeq_epi8((x), (y))
+#define VECTOR_AND(x, y)   _mm256_and_si256((x), (y))
+#define VECTOR_ANDNOT(x, y) _mm256_andnot_si256((x), (y))
+#define VECTOR_OR(x, y)    _mm256_or_si256((x), (y))
+#define VECTOR_ADD(x, y)   _mm256_add_epi8((x), (y))
+
+#elif defined(__SSE2__)
+
+typedef __m128i vector_t;
+
+#define KERNEL_NAME        ("SSE2")
+#define VECTOR_LOAD(x)     _mm_loadu_si128((const vector_t*)(x))
+#define VECTOR_STORE(x, y) _mm_storeu_si128((vector_t*)(x), (y))
+#define VECTOR_SET1(x)     _mm_set1_epi8((char)(x))
+#define VECTOR_ZERO()      _mm_setzero_si128()
+#define VECTOR_EQUAL(x, y) _mm_cmpeq_epi8((x), (y))
+#define VECTOR_AND(x, y)   _mm_and_si128((x), (y))
+#define VECTOR_ANDNOT(x, y) _mm_andnot_si128((x), (y))
+#define VECTOR_OR(x, y)    _mm_or_si128((x), (y))
+#define VECTOR_ADD(x, y)   _mm_add_epi8((x), (y))
+
+#else
+
+#define KERNEL_NAME ("scalar")
+
+#endif
+
+static const uint8_t POWERS_OF_THREE[WORD_LENGTH] = { 1, 3, 9, 27, 81 };
+
+
+// ============================================================================
+// CLASS AnswerBatch FUNCTION DEFINITIONS
+// ============================================================================
+
+
+AnswerBatch::AnswerBatch(IN std::vector<Word>& words)
+{
+  num_answers = words.size();
+  padded_num_answers = (
+    ((num_answers + BATCH_WIDTH - 1) / BATCH_WIDTH) * BATCH_WIDTH
+  );
+
+  // Padding answers are all zero bytes, which never match a letter.
+  letters.assign((size_t)WORD_LENGTH * padded_num_answers, 0);
+
+  for (uint32_t answer = 0; answer < num_answers; answer++)
+  {
+    for (uint8_t position = 0; position < WORD_LENGTH; position++)
+    {
+      letters[((size_t)position * padded_num_answers) + answer] = (
+        words[answer][position]
+      );
+    }
+  }
+
+  return;
+}
+
+
+uint32_t AnswerBatch::get_num_answers() const
+{
+  return num_answers;
+}
+
+
+uint32_t AnswerBatch::get_padded_num_answers() const
+{
+  return padded_num_answers;
+}
+
+
+const uint8_t* AnswerBatch::get_letters(IN uint8_t position) const
+{
+  return letters.data() + ((size_t)position * padded_num_answers);
+}
+
+
+// ============================================================================
+// PUBLIC FUNCTION DEFINITIONS
+// ============================================================================
+
+
+#if defined(__SSE2__)
+
+void batch_EvaluateGuess(
+  IN Word& guess, IN AnswerBatch& answers, OUT evaluation_pattern_t* patterns
+)
+{
+  const uint32_t NUM_ANSWERS = answers.get_num_answers();
+
+  const uint8_t* letter_rows[WORD_LENGTH];
+  vector_t guess_letters[WORD_LENGTH];
+  vector_t powers[WORD_LENGTH];
+  vector_t doubled_powers[WORD_LENGTH];
+  vector_t answer_letters[WORD_LENGTH];
+  vector_t greens[WORD_LENGTH];
+  vector_t claimed[WORD_LENGTH];
+  vector_t pattern;
+  vector_t found;
+  vector_t match;
+  evaluation_pattern_t tail[BATCH_WIDTH];
+
+  for (uint8_t position = 0; position < WORD_LENGTH; position++)
+  {
+    letter_rows[position] = answers.get_letters(position);
+    guess_letters[position] = VECTOR_SET1(guess[position]);
+    powers[position] = VECTOR_SET1(POWERS_OF_THREE[position]);
+    doubled_powers[position] = VECTOR_SET1(2 * POWERS_OF_THREE[position]);
+  }
+
+  for (uint32_t first = 0; first < NUM_ANSWERS; first += BATCH_WIDTH)
+  {
+    pattern = VECTOR_ZERO();
+
+    for (uint8_t position = 0; position < WORD_LENGTH; position++)
+    {
+      answer_letters[position] = VECTOR_LOAD(letter_rows[position] + first);
+      greens[position] = VECTOR_EQUAL(
+        answer_letters[position], guess_letters[position]
+      );
+      claimed[position] = greens[position];
+      pattern = VECTOR_ADD(
+        pattern, VECTOR_AND(greens[position], doubled_powers[position])
+      );
+    }
+
+    for (
+      uint8_t guess_position = 0;
+      guess_position < WORD_LENGTH;
+      guess_position++
+    )
+    {
+      // Green guess letters do not look for a yellow.
+      found = greens[guess_position];
+
+      for (
+        uint8_t answer_position = 0;
+        answer_position < WORD_LENGTH;
+        answer_position++
+      )
+      {
+        match = VECTOR_EQUAL(
+          answer_letters[answer_position], guess_letters[guess_position]
+        );
+        match = VECTOR_ANDNOT(
+          VECTOR_OR(claimed[answer_position], found), match
+        );
+        claimed[answer_position] = VECTOR_OR(claimed[answer_position], match);
+        found = VECTOR_OR(found, match);
+      }
+
+      pattern = VECTOR_ADD(
+        pattern,
+        VECTOR_AND(
+          VECTOR_ANDNOT(greens[guess_position], found), powers[guess_position]
+        )
+      );
+    }
+
+    if (first + BATCH_WIDTH <= NUM_ANSWERS)
+      VECTOR_STORE(patterns + first, pattern);
+    else
+    {
+      VECTOR_STORE(tail, pattern);
+      memcpy(patterns + first, tail, NUM_ANSWERS - first);
+    }
+  }
+
+  return;
+}
+
+#else
+
+void batch_EvaluateGuess(
+  IN Word& guess, IN AnswerBatch& answers, OUT evaluation_pattern_t* patterns
+)
+{
+  batch_EvaluateGuessScalar(guess, answers, patterns);
+  return;
+}
+
+#endif
+
+
+void batch_EvaluateGuessScalar(
+  IN Word& guess, IN AnswerBatch& answers, OUT evaluation_pattern_t* patterns
+)
+{
+  const uint32_t NUM_ANSWERS = answers.get_num_answers();
+
+  const uint8_t* letter_rows[WORD_LENGTH];
+  bool greens[WORD_LENGTH];
+  bool claimed[WORD_LENGTH];
+  evaluation_pattern_t pattern;
+
+  for (uint8_t position = 0; position < WORD_LENGTH; position++)
+    letter_rows[position] = answers.get_letters(position);
+
+  for (uint32_t answer = 0; answer < NUM_ANSWERS; answer++)
+  {
+    pattern = 0;
+
+    for (uint8_t position = 0; position < WORD_LENGTH; position++)
+    {
+      greens[position] = (letter_rows[position][answer] == guess[position]);
+      claimed[position] = greens[position];
+
+      if (greens[position])
+        pattern += 2 * POWERS_OF_THREE[position];
+    }
+
+    for (
+      uint8_t guess_position = 0;
+      guess_position < WORD_LENGTH;
+      guess_position++
+    )
+    {
+      if (greens[guess_position])
+        continue;
+
+      for (
+        uint8_t answer_position = 0;
+        answer_position < WORD_LENGTH;
+        answer_position++
+      )
+      {
+        if (
+          !claimed[answer_position]
+          && letter_rows[answer_position][answer] == guess[guess_position]
+        )
+        {
+          claimed[answer_position] = true;
+          pattern += POWERS_OF_THREE[guess_position];
+          break;
+        }
+      }
+    }
+
+    patterns[answer] = pattern;
+  }
+
+  return;
+}
+
+
+const char* batch_GetKernelName()
+{
+  return KERNEL_NAME;
+}
@@ -0,0 +1,71 @@
+#ifndef BATCHEVALUATION_H
+#define BATCHEVALUATION_H
+
+
+#include <stdint.h>
+#include <vector>
+
+#include "../../src/typehints.h"
+#include "../../src/word.h"
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+// Number of answers the vector kernel evaluates per iteration. Answer rows are
+// padded to a multiple of this.
+#if defined(__AVX2__)
+#define BATCH_WIDTH (32)
+#elif defined(__SSE2__)
+#define BATCH_WIDTH (16)
+#else
+#define BATCH_WIDTH (1)
+#endif
+
+
+// ============================================================================
+// CLASS DECLARATIONS
+// ============================================================================
+
+
+// A list of answers stored letters-by-position (structure of arrays), so that
+// the same letter position of consecutive answers is contiguous in memory.
+class AnswerBatch
+{
+  public:
+    AnswerBatch(IN std::vector<Word>& words);
+
+    uint32_t get_num_answers() const;
+    uint32_t get_padded_num_answers() const;
+    const uint8_t* get_letters(IN uint8_t position) const;
+
+  private:
+    uint32_t num_answers;
+    uint32_t padded_num_answers;
+    std::vector<uint8_t> letters;
+};
+
+
+// ============================================================================
+// PUBLIC FUNCTION DECLARATIONS
+// ============================================================================
+
+
+// Writes the packed evaluation of `guess` against every answer to `patterns`,
+// which must hold answers.get_num_answers() entries. Uses the widest vector
+// kernel the compiler was allowed to target.
+void batch_EvaluateGuess(
+  IN Word& guess, IN AnswerBatch& answers, OUT evaluation_pattern_t* patterns
+);
+
+// Same results as batch_EvaluateGuess() one answer at a time.
+void batch_EvaluateGuessScalar(
+  IN Word& guess, IN AnswerBatch& answers, OUT evaluation_pattern_t* patterns
+);
+
+const char* batch_GetKernelName();
+
+
+#endif
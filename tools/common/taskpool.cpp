@@ -0,0 +1,189 @@
+#include <chrono>
+
+#include "taskpool.h"
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+// Index of the calling thread's queue, or NO_WORKER for threads that do not
+// belong to a pool (such as the main thread).
+#define NO_WORKER (~0u)
+
+static thread_local unsigned int current_worker_index = NO_WORKER;
+
+
+// ============================================================================
+// CLASS TaskGroup FUNCTION DEFINITIONS
+// ============================================================================
+
+
+TaskGroup::TaskGroup(): num_pending_tasks(0)
+{
+  return;
+}
+
+
+bool TaskGroup::is_finished() const
+{
+  return (num_pending_tasks.load() == 0);
+}
+
+
+// ============================================================================
+// CLASS TaskPool FUNCTION DEFINITIONS
+// ============================================================================
+
+
+TaskPool::TaskPool(IN unsigned int num_threads):
+  queues(num_threads > 0 ? num_threads : 1),
+  num_queued_tasks(0),
+  next_external_queue(0),
+  stopping(false)
+{
+  for (unsigned int index = 0; index < queues.size(); index++)
+    threads.emplace_back(&TaskPool::worker_loop, this, index);
+
+  return;
+}
+
+
+TaskPool::~TaskPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(idle_mutex);
+    stopping = true;
+  }
+
+  idle_condition.notify_all();
+
+  for (std::thread& thread : threads)
+    thread.join();
+
+  return;
+}
+
+
+unsigned int TaskPool::get_num_threads() const
+{
+  return threads.size();
+}
+
+
+void TaskPool::submit(
+  MOD TaskGroup& group, IN std::function<void()>& function
+)
+{
+  unsigned int queue_index = current_worker_index;
+
+  if (queue_index == NO_WORKER)
+    queue_index = next_external_queue.fetch_add(1) % queues.size();
+
+  group.num_pending_tasks++;
+
+  {
+    std::lock_guard<std::mutex> lock(queues[queue_index].mutex);
+    queues[queue_index].tasks.push_back({ function, &group });
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(idle_mutex);
+    num_queued_tasks++;
+  }
+
+  idle_condition.notify_one();
+  return;
+}
+
+
+void TaskPool::wait(MOD TaskGroup& group)
+{
+  unsigned int queue_index = current_worker_index;
+
+  if (queue_index == NO_WORKER)
+    queue_index = 0;
+
+  // Help out instead of blocking; otherwise a worker waiting on its own
+  // children could starve the pool.
+  while (!group.is_finished())
+  {
+    if (!run_one_task(queue_index))
+      std::this_thread::yield();
+  }
+
+  return;
+}
+
+
+void TaskPool::worker_loop(IN unsigned int worker_index)
+{
+  current_worker_index = worker_index;
+
+  while (true)
+  {
+    if (run_one_task(worker_index))
+      continue;
+
+    std::unique_lock<std::mutex> lock(idle_mutex);
+
+    idle_condition.wait_for(
+      lock,
+      std::chrono::milliseconds(10),
+      [this] { return stopping || num_queued_tasks > 0; }
+    );
+
+    if (stopping && num_queued_tasks == 0)
+      break;
+  }
+
+  return;
+}
+
+
+bool TaskPool::run_one_task(IN unsigned int queue_index)
+{
+  task_t task;
+
+  if (!pop_own_task(queue_index, task) && !steal_task(queue_index, task))
+    return false;
+
+  num_queued_tasks--;
+  task.function();
+  task.group->num_pending_tasks--;
+  return true;
+}
+
+
+bool TaskPool::pop_own_task(IN unsigned int queue_index, OUT task_t& task)
+{
+  worker_queue_t& queue = queues[queue_index];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+
+  if (queue.tasks.empty())
+    return false;
+
+  task = std::move(queue.tasks.back());
+  queue.tasks.pop_back();
+  return true;
+}
+
+
+bool TaskPool::steal_task(IN unsigned int thief_index, OUT task_t& task)
+{
+  for (unsigned int offset = 1; offset < queues.size(); offset++)
+  {
+    worker_queue_t& queue = queues[(thief_index + offset) % queues.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (!queue.tasks.empty())
+    {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      return true;
+    }
+  }
+
+  return false;
+}
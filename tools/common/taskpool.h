@@ -0,0 +1,79 @@
+#ifndef TASKPOOL_H
+#define TASKPOOL_H
+
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../../src/typehints.h"
+
+
+// ============================================================================
+// CLASS DECLARATIONS
+// ============================================================================
+
+
+// Counts the unfinished tasks that were submitted under it. A task may submit
+// more tasks to its own group (fork) and then wait for them (join).
+class TaskGroup
+{
+  public:
+    TaskGroup();
+
+    bool is_finished() const;
+
+  private:
+    friend class TaskPool;
+
+    std::atomic<unsigned int> num_pending_tasks;
+};
+
+
+// A work-stealing thread pool. Every worker owns a deque: it pushes and pops
+// its own tasks at the back and steals from the front of other workers'
+// deques when its own is empty, so large subtrees are stolen first.
+class TaskPool
+{
+  public:
+    TaskPool(IN unsigned int num_threads);
+    ~TaskPool();
+
+    unsigned int get_num_threads() const;
+
+    void submit(MOD TaskGroup& group, IN std::function<void()>& function);
+    void wait(MOD TaskGroup& group);
+
+  private:
+    struct task_t
+    {
+      std::function<void()> function;
+      TaskGroup* group;
+    };
+
+    struct worker_queue_t
+    {
+      std::mutex mutex;
+      std::deque<task_t> tasks;
+    };
+
+    std::vector<std::thread> threads;
+    std::vector<worker_queue_t> queues;
+    std::mutex idle_mutex;
+    std::condition_variable idle_condition;
+    std::atomic<unsigned int> num_queued_tasks;
+    std::atomic<unsigned int> next_external_queue;
+    std::atomic<bool> stopping;
+
+    void worker_loop(IN unsigned int worker_index);
+    bool run_one_task(IN unsigned int queue_index);
+    bool pop_own_task(IN unsigned int queue_index, OUT task_t& task);
+    bool steal_task(IN unsigned int thief_index, OUT task_t& task);
+};
+
+
+#endif
@@ -0,0 +1,311 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include "../../src/word.h"
+#include "../common/appvar.h"
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+#define DEFAULT_DICTIONARY_PATH ("../appvars/GIMME5D.8xv")
+#define DEFAULT_OUTPUT_PATH     ("bin/GIMME5L.8xv")
+
+// Ladder graph appvar layout (all values little-endian):
+//
+//   [1] Format version (LADDER_GRAPH_VERSION)
+//   [3] Number of words in the dictionary the graph was built for
+//   [n] Number of neighbours of each word, one byte per word
+//   [*] Neighbour lists, one after another in dictionary order
+//
+// Two words are neighbours if they differ in exactly one position. Each list
+// is sorted and delta-coded as variable-length integers (seven bits per byte,
+// least significant first, high bit set on every byte but the last). The first
+// entry is the zigzag-coded offset from the word's own index; each later entry
+// is the gap from the previous neighbour minus one. Words that differ only in
+// their last letter are adjacent in the dictionary, so most entries take one
+// byte.
+#define LADDER_GRAPH_APPVAR  ("GIMME5L")
+#define LADDER_GRAPH_VERSION (1)
+
+typedef uint16_t word_index_t;
+
+typedef struct
+{
+  std::vector<Word> words;
+  std::vector<std::vector<word_index_t>> neighbours;
+} ladder_graph_t;
+
+
+// ============================================================================
+// STATIC FUNCTION DECLARATIONS
+// ============================================================================
+
+
+static bool load_dictionary(IN char* path, OUT ladder_graph_t& graph);
+static void build_neighbours(MOD ladder_graph_t& graph);
+static uint32_t get_largest_component_size(IN ladder_graph_t& graph);
+static void append_varint(MOD std::vector<uint8_t>& data, IN uint32_t value);
+static bool write_ladder_graph(
+  IN char* path, IN ladder_graph_t& graph, OUT size_t& data_size
+);
+static void print_usage(IN char* program_name);
+
+
+// ============================================================================
+// MAIN FUNCTION
+// ============================================================================
+
+
+int main(int argc, char** argv)
+{
+  const char* dictionary_path = DEFAULT_DICTIONARY_PATH;
+  const char* output_path = DEFAULT_OUTPUT_PATH;
+
+  ladder_graph_t graph;
+  uint32_t num_edges = 0;
+  uint32_t num_isolated_words = 0;
+  size_t data_size;
+
+  for (int index = 1; index < argc; index++)
+  {
+    if (!strcmp(argv[index], "-d") && index + 1 < argc)
+      dictionary_path = argv[++index];
+    else if (!strcmp(argv[index], "-o") && index + 1 < argc)
+      output_path = argv[++index];
+    else
+    {
+      print_usage(argv[0]);
+      return 1;
+    }
+  }
+
+  if (!load_dictionary(dictionary_path, graph))
+  {
+    fprintf(stderr, "Could not read dictionary: %s\n", dictionary_path);
+    return 1;
+  }
+
+  build_neighbours(graph);
+
+  for (const std::vector<word_index_t>& neighbours : graph.neighbours)
+  {
+    num_edges += neighbours.size();
+
+    if (neighbours.empty())
+      num_isolated_words++;
+  }
+
+  if (!write_ladder_graph(output_path, graph, data_size))
+  {
+    fprintf(stderr, "Could not write ladder graph: %s\n", output_path);
+    return 1;
+  }
+
+  printf("Dictionary:        %zu words\n", graph.words.size());
+  printf("Neighbour pairs:   %u\n", num_edges / 2);
+  printf("Isolated words:    %u\n", num_isolated_words);
+  printf("Largest component: %u words\n", get_largest_component_size(graph));
+  printf("Appvar size:       %zu bytes\n", data_size);
+  printf("Ladder graph written to %s\n", output_path);
+  return 0;
+}
+
+
+// ============================================================================
+// STATIC FUNCTION DEFINITIONS
+// ============================================================================
+
+
+static bool load_dictionary(IN char* path, OUT ladder_graph_t& graph)
+{
+  std::vector<uint8_t> data;
+  uint32_t num_words;
+
+  if (!appvar_Read(path, data) || data.size() < 3)
+    return false;
+
+  num_words = appvar_ReadUint24(data.data());
+
+  // Neighbour offsets are only ever decoded into 16-bit indices.
+  if (num_words == 0 || num_words > UINT16_MAX)
+    return false;
+
+  if (data.size() < 3 + (num_words * WORD_LENGTH))
+    return false;
+
+  graph.words.clear();
+
+  for (uint32_t index = 0; index < num_words; index++)
+  {
+    graph.words.push_back(
+      Word((char*)data.data() + 3 + (index * WORD_LENGTH))
+    );
+  }
+
+  return true;
+}
+
+
+// Tries every single-letter substitution of every word and looks the result up
+// in the sorted dictionary.
+static void build_neighbours(MOD ladder_graph_t& graph)
+{
+  const uint32_t NUM_WORDS = graph.words.size();
+
+  word_string_t word_string;
+  std::vector<Word>::const_iterator match;
+  char original_letter;
+
+  graph.neighbours.assign(NUM_WORDS, std::vector<word_index_t>());
+
+  for (uint32_t index = 0; index < NUM_WORDS; index++)
+  {
+    graph.words[index].copy_into_string(word_string);
+
+    for (uint8_t position = 0; position < WORD_LENGTH; position++)
+    {
+      original_letter = word_string[position];
+
+      for (char letter = 'A'; letter <= 'Z'; letter++)
+      {
+        if (letter == original_letter)
+          continue;
+
+        word_string[position] = letter;
+        match = std::lower_bound(
+          graph.words.begin(), graph.words.end(), Word(word_string)
+        );
+
+        if (match != graph.words.end() && *match == Word(word_string))
+          graph.neighbours[index].push_back(match - graph.words.begin());
+      }
+
+      word_string[position] = original_letter;
+    }
+
+    std::sort(graph.neighbours[index].begin(), graph.neighbours[index].end());
+  }
+
+  return;
+}
+
+
+static uint32_t get_largest_component_size(IN ladder_graph_t& graph)
+{
+  std::vector<bool> visited(graph.words.size(), false);
+  std::vector<word_index_t> stack;
+  uint32_t largest_size = 0;
+  uint32_t size;
+  word_index_t current;
+
+  for (uint32_t start = 0; start < graph.words.size(); start++)
+  {
+    if (visited[start])
+      continue;
+
+    visited[start] = true;
+    stack.push_back(start);
+    size = 0;
+
+    while (!stack.empty())
+    {
+      current = stack.back();
+      stack.pop_back();
+      size++;
+
+      for (word_index_t neighbour : graph.neighbours[current])
+      {
+        if (!visited[neighbour])
+        {
+          visited[neighbour] = true;
+          stack.push_back(neighbour);
+        }
+      }
+    }
+
+    largest_size = std::max(largest_size, size);
+  }
+
+  return largest_size;
+}
+
+
+static void append_varint(MOD std::vector<uint8_t>& data, IN uint32_t value)
+{
+  uint32_t remainder = value;
+
+  while (remainder >= 0x80)
+  {
+    data.push_back((remainder & 0x7F) | 0x80);
+    remainder >>= 7;
+  }
+
+  data.push_back(remainder);
+  return;
+}
+
+
+static bool write_ladder_graph(
+  IN char* path, IN ladder_graph_t& graph, OUT size_t& data_size
+)
+{
+  std::vector<uint8_t> data;
+  int32_t offset;
+  uint32_t zigzag_offset;
+
+  data.push_back(LADDER_GRAPH_VERSION);
+  appvar_AppendUint24(data, graph.words.size());
+
+  for (const std::vector<word_index_t>& neighbours : graph.neighbours)
+  {
+    // A word has at most 25 neighbours per position.
+    if (neighbours.size() > UINT8_MAX)
+      return false;
+
+    data.push_back(neighbours.size());
+  }
+
+  for (uint32_t index = 0; index < graph.words.size(); index++)
+  {
+    const std::vector<word_index_t>& NEIGHBOURS = graph.neighbours[index];
+
+    for (size_t subindex = 0; subindex < NEIGHBOURS.size(); subindex++)
+    {
+      if (subindex == 0)
+      {
+        offset = (int32_t)NEIGHBOURS[0] - (int32_t)index;
+        zigzag_offset = (offset >= 0 ? offset * 2 : (-offset * 2) - 1);
+        append_varint(data, zigzag_offset);
+      }
+      else
+      {
+        append_varint(
+          data, NEIGHBOURS[subindex] - NEIGHBOURS[subindex - 1] - 1
+        );
+      }
+    }
+  }
+
+  data_size = data.size();
+
+  if (data_size > APPVAR_MAX_DATA_SIZE)
+    return false;
+
+  return appvar_Write(path, LADDER_GRAPH_APPVAR, data, true);
+}
+
+
+static void print_usage(IN char* program_name)
+{
+  fprintf(
+    stderr, "Usage: %s [-d dictionary.8xv] [-o output.8xv]\n", program_name
+  );
+  return;
+}
@@ -0,0 +1,235 @@
+#include <string.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../common/appvar.h"
+#include "include/fileioc.h"
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+// fileioc has five slots, numbered from one; zero means "no slot".
+#define NUM_SLOTS (5)
+
+typedef struct
+{
+  std::vector<uint8_t> data;
+  bool archived;
+} appvar_t;
+
+typedef struct
+{
+  appvar_t* appvar;
+  std::string name;
+  size_t offset;
+  bool modified;
+} slot_t;
+
+
+static std::string appvar_directory = ".";
+static std::map<std::string, appvar_t> loaded_appvars;
+static slot_t slots[NUM_SLOTS + 1];
+
+
+// ============================================================================
+// STATIC FUNCTION DECLARATIONS
+// ============================================================================
+
+
+static std::string get_appvar_path(IN std::string& name);
+static slot_t* get_slot(IN ti_var_t slot);
+
+
+// ============================================================================
+// PUBLIC FUNCTION DEFINITIONS
+// ============================================================================
+
+
+void shim_SetAppvarDirectory(const char* directory)
+{
+  appvar_directory = directory;
+  return;
+}
+
+
+ti_var_t ti_Open(const char* name, const char* mode)
+{
+  const std::string NAME = name;
+
+  ti_var_t free_slot = 0;
+  std::map<std::string, appvar_t>::iterator iterator;
+  appvar_t appvar;
+
+  for (ti_var_t slot = 1; slot <= NUM_SLOTS; slot++)
+  {
+    if (slots[slot].appvar == NULL)
+    {
+      free_slot = slot;
+      break;
+    }
+  }
+
+  if (free_slot == 0)
+    return 0;
+
+  iterator = loaded_appvars.find(NAME);
+
+  if (iterator == loaded_appvars.end())
+  {
+    appvar.archived = false;
+
+    if (!appvar_Read(get_appvar_path(NAME).c_str(), appvar.data))
+    {
+      if (mode[0] == 'r')
+        return 0;
+    }
+
+    iterator = loaded_appvars.insert({ NAME, appvar }).first;
+  }
+
+  if (mode[0] == 'w')
+    iterator->second.data.clear();
+
+  slots[free_slot].appvar = &iterator->second;
+  slots[free_slot].name = NAME;
+  slots[free_slot].offset = (
+    mode[0] == 'a' ? iterator->second.data.size() : 0
+  );
+  slots[free_slot].modified = (mode[0] == 'w');
+  return free_slot;
+}
+
+
+int ti_Close(ti_var_t slot)
+{
+  slot_t* open_slot = get_slot(slot);
+
+  if (open_slot == NULL)
+    return 0;
+
+  if (open_slot->modified)
+  {
+    appvar_Write(
+      get_appvar_path(open_slot->name).c_str(),
+      open_slot->name.c_str(),
+      open_slot->appvar->data,
+      open_slot->appvar->archived
+    );
+  }
+
+  open_slot->appvar = NULL;
+  return 1;
+}
+
+
+size_t ti_Read(void* data, size_t size, size_t count, ti_var_t slot)
+{
+  slot_t* open_slot = get_slot(slot);
+  size_t num_elements_read = 0;
+
+  if (open_slot == NULL || size == 0)
+    return 0;
+
+  while (
+    num_elements_read < count
+    && open_slot->offset + size <= open_slot->appvar->data.size()
+  )
+  {
+    memcpy(
+      (uint8_t*)data + (num_elements_read * size),
+      open_slot->appvar->data.data() + open_slot->offset,
+      size
+    );
+    open_slot->offset += size;
+    num_elements_read++;
+  }
+
+  return num_elements_read;
+}
+
+
+size_t ti_Write(const void* data, size_t size, size_t count, ti_var_t slot)
+{
+  const size_t NUM_BYTES = size * count;
+
+  slot_t* open_slot = get_slot(slot);
+
+  if (open_slot == NULL)
+    return 0;
+
+  std::vector<uint8_t>& appvar_data = open_slot->appvar->data;
+
+  if (open_slot->offset + NUM_BYTES > appvar_data.size())
+    appvar_data.resize(open_slot->offset + NUM_BYTES);
+
+  memcpy(appvar_data.data() + open_slot->offset, data, NUM_BYTES);
+  open_slot->offset += NUM_BYTES;
+  open_slot->modified = true;
+  return count;
+}
+
+
+void* ti_GetDataPtr(ti_var_t slot)
+{
+  slot_t* open_slot = get_slot(slot);
+
+  if (open_slot == NULL)
+    return NULL;
+
+  return open_slot->appvar->data.data() + open_slot->offset;
+}
+
+
+uint8_t ti_IsArchived(ti_var_t slot)
+{
+  slot_t* open_slot = get_slot(slot);
+
+  return (open_slot != NULL && open_slot->appvar->archived);
+}
+
+
+int ti_SetArchiveStatus(bool archived, ti_var_t slot)
+{
+  slot_t* open_slot = get_slot(slot);
+
+  if (open_slot == NULL)
+    return 0;
+
+  open_slot->appvar->archived = archived;
+  return 1;
+}
+
+
+uint16_t ti_GetSize(ti_var_t slot)
+{
+  slot_t* open_slot = get_slot(slot);
+
+  if (open_slot == NULL)
+    return 0;
+
+  return open_slot->appvar->data.size();
+}
+
+
+// ============================================================================
+// STATIC FUNCTION DEFINITIONS
+// ============================================================================
+
+
+static std::string get_appvar_path(IN std::string& name)
+{
+  return appvar_directory + "/" + name + ".8xv";
+}
+
+
+static slot_t* get_slot(IN ti_var_t slot)
+{
+  if (slot == 0 || slot > NUM_SLOTS || slots[slot].appvar == NULL)
+    return NULL;
+
+  return &slots[slot];
+}
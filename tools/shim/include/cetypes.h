@@ -0,0 +1,90 @@
+#ifndef CETYPES_H
+#define CETYPES_H
+
+
+#include <stdint.h>
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+// The calculator's toolchain has native 24-bit integers. The game reads some
+// of them straight out of appvars (e.g. the dictionary's word count), so the
+// host type must occupy exactly three bytes as well.
+class uint24_t
+{
+  public:
+    uint24_t()
+    {
+      bytes[0] = bytes[1] = bytes[2] = 0;
+    }
+
+    uint24_t(uint32_t value)
+    {
+      set(value);
+    }
+
+    operator uint32_t() const
+    {
+      return bytes[0] | (bytes[1] << 8) | ((uint32_t)bytes[2] << 16);
+    }
+
+    uint24_t& operator ++()
+    {
+      set(*this + 1);
+      return *this;
+    }
+
+    uint24_t operator ++(int)
+    {
+      uint24_t previous = *this;
+
+      set(*this + 1);
+      return previous;
+    }
+
+    uint24_t& operator --()
+    {
+      set(*this - 1);
+      return *this;
+    }
+
+    uint24_t operator --(int)
+    {
+      uint24_t previous = *this;
+
+      set(*this - 1);
+      return previous;
+    }
+
+    uint24_t& operator +=(uint32_t value)
+    {
+      set(*this + value);
+      return *this;
+    }
+
+    uint24_t& operator -=(uint32_t value)
+    {
+      set(*this - value);
+      return *this;
+    }
+
+  private:
+    uint8_t bytes[3];
+
+    void set(uint32_t value)
+    {
+      bytes[0] = value & 0xFF;
+      bytes[1] = (value >> 8) & 0xFF;
+      bytes[2] = (value >> 16) & 0xFF;
+    }
+};
+
+static_assert(sizeof(uint24_t) == 3, "uint24_t must be three bytes wide");
+
+typedef int32_t int24_t;
+
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef FILEIOC_H
+#define FILEIOC_H
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+// Host stand-in for the calculator's fileioc library. Appvars are loaded from
+// `<directory>/<name>.8xv`, and the memory returned by ti_GetDataPtr() stays
+// valid after ti_Close(), just like data in the calculator's archive.
+
+typedef uint8_t ti_var_t;
+
+
+// ============================================================================
+// PUBLIC FUNCTION DECLARATIONS
+// ============================================================================
+
+
+void shim_SetAppvarDirectory(const char* directory);
+
+ti_var_t ti_Open(const char* name, const char* mode);
+int ti_Close(ti_var_t slot);
+size_t ti_Read(void* data, size_t size, size_t count, ti_var_t slot);
+size_t ti_Write(const void* data, size_t size, size_t count, ti_var_t slot);
+void* ti_GetDataPtr(ti_var_t slot);
+uint8_t ti_IsArchived(ti_var_t slot);
+int ti_SetArchiveStatus(bool archived, ti_var_t slot);
+uint16_t ti_GetSize(ti_var_t slot);
+
+
+#endif
@@ -0,0 +1,636 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "../../src/word.h"
+#include "../common/appvar.h"
+#include "../common/batchevaluation.h"
+#include "../common/taskpool.h"
+
+
+// ============================================================================
+// DEFINITIONS
+// ============================================================================
+
+
+#define DEFAULT_DICTIONARY_PATH ("../appvars/GIMME5D.8xv")
+#define DEFAULT_OUTPUT_PATH     ("bin/GIMME5O.8xv")
+#define DEFAULT_BEAM_WIDTH      (8)
+
+// Opening book appvar layout (all values little-endian):
+//
+//   [  1] Format version (OPENING_BOOK_VERSION)
+//   [  3] Number of words in the dictionary the book was built for
+//   [  2] Dictionary index of the opening guess
+//   [486] Dictionary index of the second guess for each of the
+//         NUM_EVALUATION_PATTERNS evaluations of the opening guess, or
+//         NO_GUESS if no target produces that evaluation
+//
+// The calculator can find the second guess with a single table lookup.
+#define OPENING_BOOK_APPVAR  ("GIMME5O")
+#define OPENING_BOOK_VERSION (1)
+#define NO_GUESS             (0xFFFF)
+
+#define ALL_CORRECT_PATTERN (NUM_EVALUATION_PATTERNS - 1)
+
+// Subtrees with at least this many candidates are handed to the task pool;
+// smaller ones are cheaper to build inline than to schedule.
+#define PARALLEL_SUBTREE_THRESHOLD (32)
+#define PATTERN_ROWS_PER_TASK      (64)
+#define MAX_TRACKED_DEPTH          (16)
+
+typedef uint16_t word_index_t;
+
+typedef struct
+{
+  uint64_t total_num_guesses;
+  uint8_t max_num_guesses;
+  uint32_t num_solved_at_depth[MAX_TRACKED_DEPTH + 1];
+} tree_statistics_t;
+
+typedef struct
+{
+  uint32_t score;
+  word_index_t guess;
+} guess_score_t;
+
+typedef struct
+{
+  std::vector<Word> words;
+  uint32_t num_words;
+  AnswerBatch* answers;
+  std::vector<evaluation_pattern_t> patterns;
+  TaskPool* pool;
+} solver_t;
+
+
+// ============================================================================
+// STATIC FUNCTION DECLARATIONS
+// ============================================================================
+
+
+static bool load_dictionary(IN char* path, OUT solver_t& solver);
+static void build_pattern_table(MOD solver_t& solver);
+static evaluation_pattern_t get_pattern(
+  IN solver_t& solver, IN word_index_t guess, IN word_index_t target
+);
+static uint32_t score_guess(
+  IN solver_t& solver,
+  IN word_index_t guess,
+  IN std::vector<word_index_t>& candidates
+);
+static word_index_t choose_guess(
+  IN solver_t& solver, IN std::vector<word_index_t>& candidates
+);
+static std::vector<guess_score_t> rank_opening_guesses(MOD solver_t& solver);
+static void build_subtree(
+  IN solver_t& solver,
+  IN std::vector<word_index_t>& candidates,
+  IN uint8_t depth,
+  IN word_index_t forced_guess,
+  OUT tree_statistics_t& statistics,
+  OUT word_index_t& chosen_guess,
+  OUT word_index_t* second_level_guesses
+);
+static void reset_statistics(OUT tree_statistics_t& statistics);
+static void merge_statistics(
+  MOD tree_statistics_t& statistics, IN tree_statistics_t& subtree_statistics
+);
+static bool is_better_tree(
+  IN tree_statistics_t& first, IN tree_statistics_t& second
+);
+static bool write_opening_book(
+  IN char* path,
+  IN solver_t& solver,
+  IN word_index_t opening_guess,
+  IN word_index_t* second_level_guesses
+);
+static void print_report(
+  IN solver_t& solver,
+  IN word_index_t opening_guess,
+  IN tree_statistics_t& statistics
+);
+static void print_usage(IN char* program_name);
+
+
+// ============================================================================
+// MAIN FUNCTION
+// ============================================================================
+
+
+int main(int argc, char** argv)
+{
+  const char* dictionary_path = DEFAULT_DICTIONARY_PATH;
+  const char* output_path = DEFAULT_OUTPUT_PATH;
+  unsigned int num_threads = std::thread::hardware_concurrency();
+  unsigned int beam_width = DEFAULT_BEAM_WIDTH;
+
+  solver_t solver;
+  std::vector<word_index_t> all_words;
+  std::vector<guess_score_t> ranked_guesses;
+  std::vector<tree_statistics_t> beam_statistics;
+  std::vector<std::vector<word_index_t>> beam_second_levels;
+  TaskGroup group;
+  unsigned int best_beam_index = 0;
+  word_index_t opening_guess;
+
+  for (int index = 1; index < argc; index++)
+  {
+    if (!strcmp(argv[index], "-d") && index + 1 < argc)
+      dictionary_path = argv[++index];
+    else if (!strcmp(argv[index], "-o") && index + 1 < argc)
+      output_path = argv[++index];
+    else if (!strcmp(argv[index], "-j") && index + 1 < argc)
+      num_threads = atoi(argv[++index]);
+    else if (!strcmp(argv[index], "-b") && index + 1 < argc)
+      beam_width = atoi(argv[++index]);
+    else
+    {
+      print_usage(argv[0]);
+      return 1;
+    }
+  }
+
+  if (num_threads == 0)
+    num_threads = 1;
+
+  if (beam_width == 0)
+    beam_width = 1;
+
+  if (!load_dictionary(dictionary_path, solver))
+  {
+    fprintf(stderr, "Could not read dictionary: %s\n", dictionary_path);
+    return 1;
+  }
+
+  TaskPool pool(num_threads);
+  AnswerBatch answers(solver.words);
+  solver.pool = &pool;
+  solver.answers = &answers;
+
+  printf("Dictionary:      %u words\n", solver.num_words);
+  printf("Threads:         %u\n", pool.get_num_threads());
+  printf("Beam width:      %u\n", beam_width);
+  printf("Kernel:          %s\n", batch_GetKernelName());
+
+  build_pattern_table(solver);
+  ranked_guesses = rank_opening_guesses(solver);
+
+  for (uint32_t index = 0; index < solver.num_words; index++)
+    all_words.push_back(index);
+
+  // Build a complete greedy tree under each of the best-scoring openers and
+  // keep the one whose tree actually needs the fewest guesses.
+  beam_width = std::min<unsigned int>(beam_width, ranked_guesses.size());
+  beam_statistics.resize(beam_width);
+  beam_second_levels.assign(
+    beam_width, std::vector<word_index_t>(NUM_EVALUATION_PATTERNS, NO_GUESS)
+  );
+
+  for (unsigned int beam_index = 0; beam_index < beam_width; beam_index++)
+  {
+    pool.submit(
+      group,
+      [&, beam_index]() {
+        word_index_t chosen_guess;
+
+        build_subtree(
+          solver,
+          all_words,
+          1,
+          ranked_guesses[beam_index].guess,
+          beam_statistics[beam_index],
+          chosen_guess,
+          beam_second_levels[beam_index].data()
+        );
+      }
+    );
+  }
+
+  pool.wait(group);
+
+  for (unsigned int beam_index = 1; beam_index < beam_width; beam_index++)
+  {
+    if (
+      is_better_tree(
+        beam_statistics[beam_index], beam_statistics[best_beam_index]
+      )
+    )
+    {
+      best_beam_index = beam_index;
+    }
+  }
+
+  opening_guess = ranked_guesses[best_beam_index].guess;
+  print_report(solver, opening_guess, beam_statistics[best_beam_index]);
+
+  if (
+    !write_opening_book(
+      output_path,
+      solver,
+      opening_guess,
+      beam_second_levels[best_beam_index].data()
+    )
+  )
+  {
+    fprintf(stderr, "Could not write opening book: %s\n", output_path);
+    return 1;
+  }
+
+  printf("Wrote:           %s\n", output_path);
+  return 0;
+}
+
+
+// ============================================================================
+// STATIC FUNCTION DEFINITIONS
+// ============================================================================
+
+
+static bool load_dictionary(IN char* path, OUT solver_t& solver)
+{
+  std::vector<uint8_t> data;
+  uint32_t num_words;
+
+  if (!appvar_Read(path, data) || data.size() < 3)
+    return false;
+
+  num_words = appvar_ReadUint24(data.data());
+
+  if (num_words == 0 || num_words >= NO_GUESS)
+    return false;
+
+  if (data.size() < 3 + (num_words * WORD_LENGTH))
+    return false;
+
+  solver.words.clear();
+
+  for (uint32_t index = 0; index < num_words; index++)
+  {
+    solver.words.push_back(
+      Word((char*)data.data() + 3 + (index * WORD_LENGTH))
+    );
+  }
+
+  solver.num_words = num_words;
+  return true;
+}
+
+
+static void build_pattern_table(MOD solver_t& solver)
+{
+  const uint32_t NUM_WORDS = solver.num_words;
+
+  TaskGroup group;
+
+  solver.patterns.resize((size_t)NUM_WORDS * NUM_WORDS);
+
+  for (
+    uint32_t first_row = 0;
+    first_row < NUM_WORDS;
+    first_row += PATTERN_ROWS_PER_TASK
+  )
+  {
+    solver.pool->submit(
+      group,
+      [&solver, first_row, NUM_WORDS]() {
+        const uint32_t LAST_ROW = std::min<uint32_t>(
+          first_row + PATTERN_ROWS_PER_TASK, NUM_WORDS
+        );
+
+        for (uint32_t guess = first_row; guess < LAST_ROW; guess++)
+        {
+          batch_EvaluateGuess(
+            solver.words[guess],
+            *solver.answers,
+            solver.patterns.data() + ((size_t)guess * NUM_WORDS)
+          );
+        }
+      }
+    );
+  }
+
+  solver.pool->wait(group);
+  return;
+}
+
+
+static evaluation_pattern_t get_pattern(
+  IN solver_t& solver, IN word_index_t guess, IN word_index_t target
+)
+{
+  return solver.patterns[((size_t)guess * solver.num_words) + target];
+}
+
+
+// Returns the sum of the squared bucket sizes, which is proportional to the
+// expected number of candidates left after making the guess.
+static uint32_t score_guess(
+  IN solver_t& solver,
+  IN word_index_t guess,
+  IN std::vector<word_index_t>& candidates
+)
+{
+  uint32_t bucket_sizes[NUM_EVALUATION_PATTERNS] = { 0 };
+  uint32_t score = 0;
+
+  for (word_index_t target : candidates)
+    bucket_sizes[get_pattern(solver, guess, target)]++;
+
+  for (uint32_t bucket_size : bucket_sizes)
+    score += bucket_size * bucket_size;
+
+  return score;
+}
+
+
+static word_index_t choose_guess(
+  IN solver_t& solver, IN std::vector<word_index_t>& candidates
+)
+{
+  std::vector<bool> is_candidate(solver.num_words, false);
+  word_index_t best_guess = candidates[0];
+  uint32_t best_score;
+  bool best_is_candidate = true;
+  uint32_t score;
+
+  if (candidates.size() <= 2)
+    return candidates[0];
+
+  for (word_index_t candidate : candidates)
+    is_candidate[candidate] = true;
+
+  best_score = score_guess(solver, best_guess, candidates);
+
+  for (word_index_t guess = 0; guess < solver.num_words; guess++)
+  {
+    score = score_guess(solver, guess, candidates);
+
+    // On a tie, prefer a guess that could be the target itself.
+    if (
+      score < best_score
+      || (score == best_score && is_candidate[guess] && !best_is_candidate)
+    )
+    {
+      best_guess = guess;
+      best_score = score;
+      best_is_candidate = is_candidate[guess];
+    }
+  }
+
+  return best_guess;
+}
+
+
+static std::vector<guess_score_t> rank_opening_guesses(MOD solver_t& solver)
+{
+  std::vector<guess_score_t> ranked_guesses(solver.num_words);
+  std::vector<word_index_t> all_words;
+  TaskGroup group;
+
+  for (uint32_t index = 0; index < solver.num_words; index++)
+    all_words.push_back(index);
+
+  for (
+    uint32_t first_guess = 0;
+    first_guess < solver.num_words;
+    first_guess += PATTERN_ROWS_PER_TASK
+  )
+  {
+    solver.pool->submit(
+      group,
+      [&, first_guess]() {
+        const uint32_t LAST_GUESS = std::min<uint32_t>(
+          first_guess + PATTERN_ROWS_PER_TASK, solver.num_words
+        );
+
+        for (uint32_t guess = first_guess; guess < LAST_GUESS; guess++)
+        {
+          ranked_guesses[guess].guess = guess;
+          ranked_guesses[guess].score = score_guess(solver, guess, all_words);
+        }
+      }
+    );
+  }
+
+  solver.pool->wait(group);
+
+  std::sort(
+    ranked_guesses.begin(),
+    ranked_guesses.end(),
+    [](IN guess_score_t& first, IN guess_score_t& second) {
+      if (first.score != second.score)
+        return first.score < second.score;
+
+      return first.guess < second.guess;
+    }
+  );
+
+  return ranked_guesses;
+}
+
+
+// Builds the greedy decision tree for `candidates` where the next guess is
+// guess number `depth`. Only the statistics are kept, along with the second
+// guesses when `second_level_guesses` is given (i.e. at the root).
+static void build_subtree(
+  IN solver_t& solver,
+  IN std::vector<word_index_t>& candidates,
+  IN uint8_t depth,
+  IN word_index_t forced_guess,
+  OUT tree_statistics_t& statistics,
+  OUT word_index_t& chosen_guess,
+  OUT word_index_t* second_level_guesses
+)
+{
+  std::vector<std::vector<word_index_t>> buckets(NUM_EVALUATION_PATTERNS);
+  std::vector<tree_statistics_t> bucket_statistics(NUM_EVALUATION_PATTERNS);
+  std::vector<word_index_t> bucket_guesses(NUM_EVALUATION_PATTERNS, NO_GUESS);
+  TaskGroup group;
+  evaluation_pattern_t pattern;
+
+  reset_statistics(statistics);
+
+  if (forced_guess != NO_GUESS)
+    chosen_guess = forced_guess;
+  else
+    chosen_guess = choose_guess(solver, candidates);
+
+  for (word_index_t target : candidates)
+  {
+    pattern = get_pattern(solver, chosen_guess, target);
+
+    if (pattern == ALL_CORRECT_PATTERN)
+    {
+      statistics.total_num_guesses += depth;
+      statistics.max_num_guesses = std::max(statistics.max_num_guesses, depth);
+      statistics.num_solved_at_depth[
+        std::min(depth, (uint8_t)MAX_TRACKED_DEPTH)
+      ]++;
+    }
+    else
+    {
+      buckets[pattern].push_back(target);
+    }
+  }
+
+  for (uint16_t index = 0; index < NUM_EVALUATION_PATTERNS; index++)
+  {
+    if (buckets[index].empty())
+      continue;
+
+    if (buckets[index].size() >= PARALLEL_SUBTREE_THRESHOLD)
+    {
+      solver.pool->submit(
+        group,
+        [&, index]() {
+          build_subtree(
+            solver,
+            buckets[index],
+            depth + 1,
+            NO_GUESS,
+            bucket_statistics[index],
+            bucket_guesses[index],
+            NULL
+          );
+        }
+      );
+    }
+    else
+    {
+      build_subtree(
+        solver,
+        buckets[index],
+        depth + 1,
+        NO_GUESS,
+        bucket_statistics[index],
+        bucket_guesses[index],
+        NULL
+      );
+    }
+  }
+
+  solver.pool->wait(group);
+
+  for (uint16_t index = 0; index < NUM_EVALUATION_PATTERNS; index++)
+  {
+    if (!buckets[index].empty())
+      merge_statistics(statistics, bucket_statistics[index]);
+
+    if (second_level_guesses != NULL)
+      second_level_guesses[index] = bucket_guesses[index];
+  }
+
+  if (second_level_guesses != NULL)
+    second_level_guesses[ALL_CORRECT_PATTERN] = NO_GUESS;
+
+  return;
+}
+
+
+static void reset_statistics(OUT tree_statistics_t& statistics)
+{
+  memset(&statistics, 0, sizeof statistics);
+  return;
+}
+
+
+static void merge_statistics(
+  MOD tree_statistics_t& statistics, IN tree_statistics_t& subtree_statistics
+)
+{
+  statistics.total_num_guesses += subtree_statistics.total_num_guesses;
+  statistics.max_num_guesses = std::max(
+    statistics.max_num_guesses, subtree_statistics.max_num_guesses
+  );
+
+  for (uint8_t depth = 0; depth <= MAX_TRACKED_DEPTH; depth++)
+  {
+    statistics.num_solved_at_depth[depth] += (
+      subtree_statistics.num_solved_at_depth[depth]
+    );
+  }
+
+  return;
+}
+
+
+static bool is_better_tree(
+  IN tree_statistics_t& first, IN tree_statistics_t& second
+)
+{
+  if (first.total_num_guesses != second.total_num_guesses)
+    return first.total_num_guesses < second.total_num_guesses;
+
+  return first.max_num_guesses < second.max_num_guesses;
+}
+
+
+static bool write_opening_book(
+  IN char* path,
+  IN solver_t& solver,
+  IN word_index_t opening_guess,
+  IN word_index_t* second_level_guesses
+)
+{
+  std::vector<uint8_t> data;
+
+  data.push_back(OPENING_BOOK_VERSION);
+  appvar_AppendUint24(data, solver.num_words);
+  appvar_AppendUint16(data, opening_guess);
+
+  for (uint16_t index = 0; index < NUM_EVALUATION_PATTERNS; index++)
+    appvar_AppendUint16(data, second_level_guesses[index]);
+
+  return appvar_Write(path, OPENING_BOOK_APPVAR, data, true);
+}
+
+
+static void print_report(
+  IN solver_t& solver,
+  IN word_index_t opening_guess,
+  IN tree_statistics_t& statistics
+)
+{
+  word_string_t opening_guess_string;
+
+  solver.words[opening_guess].copy_into_string(opening_guess_string);
+
+  printf("Opening guess:   %.5s\n", opening_guess_string);
+  printf(
+    "Average guesses: %.4f\n",
+    (double)statistics.total_num_guesses / solver.num_words
+  );
+  printf("Worst case:      %u guesses\n", statistics.max_num_guesses);
+  printf("Distribution:\n");
+
+  for (uint8_t depth = 1; depth <= MAX_TRACKED_DEPTH; depth++)
+  {
+    if (statistics.num_solved_at_depth[depth] > 0)
+    {
+      printf(
+        "  %2u guess%s %6u\n",
+        depth,
+        (depth == 1 ? ": " : "es:"),
+        statistics.num_solved_at_depth[depth]
+      );
+    }
+  }
+
+  return;
+}
+
+
+static void print_usage(IN char* program_name)
+{
+  fprintf(
+    stderr,
+    "Usage: %s [-d dictionary.8xv] [-o output.8xv] [-j threads] [-b beam]\n",
+    program_name
+  );
+  return;
+}
@@ -0,0 +1,86 @@
+#include <stdio.h>
+#include <vector>
+
+#include "../../../src/word.h"
+#include "../../common/appvar.h"
+#include "../../common/batchevaluation.h"
+
+
+#define DICTIONARY_PATH ("../appvars/GIMME5D.8xv")
+
+
+static bool load_words(OUT std::vector<Word>& words);
+static bool test(IN std::vector<Word>& words);
+
+
+int main(void)
+{
+  std::vector<Word> words;
+
+  if (!load_words(words))
+  {
+    fprintf(stderr, "Could not read dictionary: %s\n", DICTIONARY_PATH);
+    return 1;
+  }
+
+  printf("batchevaluation (%s): ", batch_GetKernelName());
+
+  if (test(words))
+  {
+    printf("PASSED\n");
+    return 0;
+  }
+
+  printf("FAILED\n");
+  return 1;
+}
+
+
+static bool load_words(OUT std::vector<Word>& words)
+{
+  std::vector<uint8_t> data;
+  uint32_t num_words;
+
+  if (!appvar_Read(DICTIONARY_PATH, data) || data.size() < 3)
+    return false;
+
+  num_words = appvar_ReadUint24(data.data());
+
+  if (data.size() < 3 + (num_words * WORD_LENGTH))
+    return false;
+
+  for (uint32_t index = 0; index < num_words; index++)
+    words.push_back(Word((char*)data.data() + 3 + (index * WORD_LENGTH)));
+
+  return !words.empty();
+}
+
+
+// Every dictionary word is evaluated against every other, which covers
+// repeated letters in both the guess and the answer. The dictionary size is
+// not a multiple of BATCH_WIDTH, so the partial last batch is covered too.
+static bool test(IN std::vector<Word>& words)
+{
+  AnswerBatch answers(words);
+  std::vector<evaluation_pattern_t> patterns(words.size());
+  std::vector<evaluation_pattern_t> scalar_patterns(words.size());
+  word_evaluation_t evaluation;
+  evaluation_pattern_t expected;
+
+  for (IN Word& guess : words)
+  {
+    batch_EvaluateGuess(guess, answers, patterns.data());
+    batch_EvaluateGuessScalar(guess, answers, scalar_patterns.data());
+
+    for (uint32_t answer = 0; answer < words.size(); answer++)
+    {
+      word_EvaluateFirstWordBySecondWord(guess, words[answer], evaluation);
+      expected = word_EncodeEvaluation(evaluation);
+
+      if (patterns[answer] != expected || scalar_patterns[answer] != expected)
+        return false;
+    }
+  }
+
+  return true;
+}